@@ -6,7 +6,10 @@
 
 #pragma once
 
-#include <any>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <cstdint>
 #include <cstring>
 #include <filesystem>
@@ -14,17 +17,49 @@
 #include <iostream>
 #include <memory>
 #include <string>
-#include <map>
+#include <string_view>
+#include <memory_resource>
 #include <stack>
 #include <fstream>
 #include <format>
 #include <functional>
-#include <unordered_set>
+#include <iterator>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
 #include <variant>
 #include <vector>
 #include <cassert>
+#include <charconv>
+#include <cmath>
 #include <source_location>
+#include <span>
 #include <type_traits>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64)
+#	define LJSON_X86_64
+#	include <immintrin.h>
+#	if defined(_MSC_VER)
+#		include <intrin.h>
+#	endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#	define LJSON_ARM64
+#	include <arm_neon.h>
+#endif
+
+#if defined(LJSON_X86_64) && (defined(__GNUC__) || defined(__clang__))
+#	define LJSON_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#	define LJSON_TARGET_AVX2
+#endif
 
 /**
  * @brief the namespace for ljson
@@ -323,6 +358,8 @@ namespace ljson {
 		parsing_error_wrong_type,
 		wrong_type,
 		wronge_index,
+		number_out_of_range,
+		parsing_stopped,
 	};
 
 	/**
@@ -330,9 +367,23 @@ namespace ljson {
 	 * @brief a class type inspired by std::error_code to handle errors
 	 */
 	class error {
+		public:
+			/**
+			 * @brief a message which is only formatted when message() or what() is called, so creating the
+			 * error doesn't allocate. the format string and the arguments have to outlive the error, in
+			 * practice they are string literals
+			 */
+			struct lazy_message {
+					const char* fmt	   = nullptr;
+					const char* first  = "";
+					const char* second = "";
+			};
+
 		private:
-			error_type  err_type;
-			std::string msg;
+			error_type			  err_type;
+			std::string			  msg;
+			lazy_message			  lazy;
+			mutable std::atomic<std::string*> formatted = nullptr;
 
 		public:
 			/**
@@ -342,6 +393,13 @@ namespace ljson {
 			 */
 			error(error_type err, const std::string& message) noexcept;
 
+			/**
+			 * @brief constructor which defers formatting the message
+			 * @param err holds the value of ljson::error_type
+			 * @param message format string and arguments of the message
+			 */
+			error(error_type err, lazy_message message) noexcept;
+
 			/**
 			 * @brief constructor
 			 * @param err holds the value of ljson::error_type
@@ -352,6 +410,19 @@ namespace ljson {
 			template<typename... args_t>
 			error(error_type err, std::format_string<args_t...> fmt, args_t&&... args) noexcept;
 
+			/**
+			 * @brief copy constructor, the copy formats a lazy message again when it is asked for
+			 */
+			error(const error& other);
+
+			error(error&& other) noexcept;
+
+			error& operator=(const error& other);
+
+			error& operator=(error&& other) noexcept;
+
+			~error();
+
 			/**
 			 * @brief get the string message of the error
 			 * @return get the string message of the error
@@ -397,24 +468,26 @@ namespace ljson {
 		value,
 	};
 
-	enum class json_syntax {
-		opening_bracket,
-		closing_bracket,
-		quotes_1,
-		quotes_2,
-		column,
-		string_value,
-		object,
-		array,
-		maybe_empty_space_after,
-		flush_value,
+	/**
+	 * @brief the output style of ljson::node::dump. pretty writes newlines and indentation, compact writes
+	 * no whitespace at all
+	 * @detail @cpp
+	 * std::string minified = node.dump_to_string(ljson::dump_style::compact);
+	 * @ecpp
+	 */
+	enum class dump_style {
+		pretty,
+		compact,
 	};
 
-	enum class key_type {
-		none,
-		simple_key,
-		object,
-		array,
+	enum class json_syntax {
+		root,
+		key_or_end,
+		column,
+		value,
+		value_or_end,
+		end_statement,
+		done,
 	};
 
 	/**
@@ -438,6 +511,14 @@ namespace ljson {
 
 	inline null_type null;
 
+	/**
+	 * @brief the standard integer type with the size and signedness of an integral type. std::in_range() doesn't
+	 * take the character types (char, wchar_t, char8_t, char16_t, char32_t), so they are compared as this type
+	 */
+	template<typename integral_type>
+	using standard_integer_t = std::conditional_t<std::is_signed_v<integral_type>, std::make_signed_t<integral_type>,
+	    std::make_unsigned_t<integral_type>>;
+
 	/**
 	  @brief puts a constraint on the allowed json types for ljson::value
 	 */
@@ -456,6 +537,8 @@ namespace ljson {
 			value_type_variant _value = monostate();
 			value_type	   _type  = value_type::none;
 
+			friend class node;
+
 			template<is_allowed_value_type val_type>
 			void set_state(const val_type& val) noexcept
 			{
@@ -464,18 +547,25 @@ namespace ljson {
 					_type  = value_type::boolean;
 					_value = val;
 				}
+				else if constexpr (std::is_floating_point_v<val_type>)
+				{
+					_type  = value_type::double_t;
+					_value = static_cast<double>(val);
+				}
 				else if constexpr (std::is_arithmetic_v<val_type>)
 				{
-					if constexpr (std::is_floating_point_v<val_type>)
+					// unsigned values past INT64_MAX don't fit in a json integer, keep them as a double. a character
+					// is stored as its code
+					if (std::in_range<int64_t>(static_cast<standard_integer_t<val_type>>(val)))
 					{
-						_type = value_type::double_t;
+						_type  = value_type::integer;
+						_value = static_cast<int64_t>(val);
 					}
 					else
 					{
-						_type = value_type::integer;
+						_type  = value_type::double_t;
+						_value = static_cast<double>(val);
 					}
-
-					_value = val;
 				}
 				else if constexpr (std::is_same_v<val_type, std::string> || std::is_same_v<val_type, const char*> ||
 						   std::is_same_v<val_type, char*>)
@@ -499,6 +589,20 @@ namespace ljson {
 				}
 			}
 
+			template<typename number_type>
+			expected<monostate, error> set_number(const std::string& val)
+			{
+				number_type number = 0;
+				auto [end, ec]	   = std::from_chars(val.data(), val.data() + val.size(), number);
+				if (ec == std::errc::result_out_of_range)
+					return unexpected(error(error_type::number_out_of_range, "number out of range: '{}'", val));
+				else if (ec != std::errc() || end != val.data() + val.size())
+					return unexpected(error(error_type::wrong_type, "'{}' is not a number", val));
+
+				_value = number;
+				return monostate();
+			}
+
 			expected<monostate, error> set_state(const std::string& val, value_type t)
 			{
 				_type = t;
@@ -506,10 +610,14 @@ namespace ljson {
 				{
 					case value_type::double_t:
 					case value_type::number:
-						_value = std::stod(val);
-						break;
 					case value_type::integer:
-						_value = std::stoll(val);
+						if (auto ok = t == value_type::integer ? this->set_number<int64_t>(val) : this->set_number<double>(val);
+						    not ok)
+						{
+							_type  = value_type::none;
+							_value = monostate();
+							return ok;
+						}
 						break;
 					case value_type::string:
 						_value = val;
@@ -705,27 +813,37 @@ namespace ljson {
 			 * @return std::string or ljson::error if it doesn't hold a string
 			 * @see as_string()
 			 */
-			expected<std::string, error> try_as_string() noexcept
+			expected<std::string, error> try_as_string() const noexcept
 			{
 				if (not this->is_string())
-					return unexpected(error(error_type::wrong_type,
-					    "wrong type: trying to cast the value '{}' which is a '{}' to 'string'", this->stringify(),
-					    this->type_name()));
+					return unexpected(this->cast_error("string"));
 
 				return std::get<std::string>(_value);
 			}
 
+			/**
+			 * @brief view the json string ljson::value is holding without copying it. the view is valid as long
+			 * as the ljson::value isn't changed or destroyed
+			 * @return std::string_view or ljson::error if it doesn't hold a string
+			 * @see as_string_view()
+			 */
+			expected<std::string_view, error> try_as_string_view() const noexcept
+			{
+				if (not this->is_string())
+					return unexpected(this->cast_error("string"));
+
+				return std::string_view(std::get<std::string>(_value));
+			}
+
 			/**
 			 * @brief cast ljson::value into a double if it is holding a json number (double or int64_t)
 			 * @return double or ljson::error if it doesn't hold a number
 			 * @see as_number()
 			 */
-			expected<double, error> try_as_number() noexcept
+			expected<double, error> try_as_number() const noexcept
 			{
 				if (not this->is_number())
-					return unexpected(error(error_type::wrong_type,
-					    "wrong type: trying to cast the value '{}' which is a '{}' to 'number'", this->stringify(),
-					    this->type_name()));
+					return unexpected(this->cast_error("number"));
 
 				if (this->is_double())
 					return std::get<double>(_value);
@@ -738,12 +856,10 @@ namespace ljson {
 			 * @return int64_t or ljson::error if it doesn't hold a number
 			 * @see as_integer()
 			 */
-			expected<int64_t, error> try_as_integer() noexcept
+			expected<int64_t, error> try_as_integer() const noexcept
 			{
 				if (not this->is_integer())
-					return unexpected(error(error_type::wrong_type,
-					    "wrong type: trying to cast the value '{}' which is a '{}' to 'integer'", this->stringify(),
-					    this->type_name()));
+					return unexpected(this->cast_error("integer"));
 
 				return std::get<int64_t>(_value);
 			}
@@ -753,12 +869,10 @@ namespace ljson {
 			 * @return double or ljson::error if it doesn't hold a number
 			 * @see as_double()
 			 */
-			expected<double, error> try_as_double() noexcept
+			expected<double, error> try_as_double() const noexcept
 			{
 				if (not this->is_double())
-					return unexpected(error(error_type::wrong_type,
-					    "wrong type: trying to cast the value '{}' which is a '{}' to 'double'", this->stringify(),
-					    this->type_name()));
+					return unexpected(this->cast_error("double"));
 
 				return std::get<double>(_value);
 			}
@@ -768,12 +882,10 @@ namespace ljson {
 			 * @return bool or ljson::error if it doesn't hold a boolean
 			 * @see as_boolean()
 			 */
-			expected<bool, error> try_as_boolean() noexcept
+			expected<bool, error> try_as_boolean() const noexcept
 			{
 				if (not this->is_boolean())
-					return unexpected(error(error_type::wrong_type,
-					    "wrong type: trying to cast the value '{}' which is a '{}' to 'boolean'", this->stringify(),
-					    this->type_name()));
+					return unexpected(this->cast_error("boolean"));
 
 				return std::get<bool>(_value);
 			}
@@ -783,12 +895,10 @@ namespace ljson {
 			 * @return ljson::null_type or ljson::error if it doesn't hold a null
 			 * @see as_null()
 			 */
-			expected<null_type, error> try_as_null() noexcept
+			expected<null_type, error> try_as_null() const noexcept
 			{
 				if (not this->is_null())
-					return unexpected(error(error_type::wrong_type,
-					    "wrong type: trying to cast the value '{}' which is a '{}' to 'null'", this->stringify(),
-					    this->type_name()));
+					return unexpected(this->cast_error("null"));
 
 				return std::get<null_type>(_value);
 			}
@@ -799,7 +909,7 @@ namespace ljson {
 			 * @return json string
 			 * @see try_as_string()
 			 */
-			std::string as_string()
+			std::string as_string() const
 			{
 				auto ok = this->try_as_string();
 				if (not ok)
@@ -808,13 +918,28 @@ namespace ljson {
 				return ok.value();
 			}
 
+			/**
+			 * @brief view the json string ljson::value is holding without copying it
+			 * @exception ljson::error if it doesn't hold a json string
+			 * @return json string
+			 * @see try_as_string_view()
+			 */
+			std::string_view as_string_view() const
+			{
+				auto ok = this->try_as_string_view();
+				if (not ok)
+					throw ok.error();
+
+				return ok.value();
+			}
+
 			/**
 			 * @brief cast ljson::value into a number if it is holding a json number (double or int64_t)
 			 * @exception ljson::error if it doesn't hold json number
 			 * @return json number
 			 * @see try_as_number()
 			 */
-			double as_number()
+			double as_number() const
 			{
 				auto ok = this->try_as_number();
 				if (not ok)
@@ -829,7 +954,7 @@ namespace ljson {
 			 * @return json number
 			 * @see try_as_integer()
 			 */
-			int64_t as_integer()
+			int64_t as_integer() const
 			{
 				auto ok = this->try_as_integer();
 				if (not ok)
@@ -844,7 +969,7 @@ namespace ljson {
 			 * @return json number
 			 * @see try_as_double()
 			 */
-			double as_double()
+			double as_double() const
 			{
 				auto ok = this->try_as_double();
 				if (not ok)
@@ -859,7 +984,7 @@ namespace ljson {
 			 * @return json boolean
 			 * @see try_as_boolean()
 			 */
-			bool as_boolean()
+			bool as_boolean() const
 			{
 				auto ok = this->try_as_boolean();
 				if (not ok)
@@ -874,7 +999,7 @@ namespace ljson {
 			 * @return json null
 			 * @see try_as_null()
 			 */
-			null_type as_null()
+			null_type as_null() const
 			{
 				auto ok = this->try_as_null();
 				if (not ok)
@@ -889,62 +1014,55 @@ namespace ljson {
 			 */
 			std::string stringify() const noexcept
 			{
-				if (this->is_double())
-				{
-					std::string str = std::to_string(std::get<double>(_value));
+				std::string str;
+				this->stringify_to(str);
 
-					auto pop_zeros_at_the_end = [&]()
-					{
-						bool found_zero = false;
-						for (size_t i = str.size() - 1;; i--)
-						{
-							if (str[i] == '0' && not found_zero)
-							{
-								found_zero = true;
-							}
-							else if (str[i] == '0' && found_zero)
-							{
-								str.pop_back();
-							}
-							else if (found_zero)
-							{
-								str.pop_back();
-								found_zero = false;
-							}
-							else
-								break;
-
-							if (i == 0)
-								break;
-						}
+				return str;
+			}
 
-						if (not str.empty() && str.back() == '.')
-							str += "0";
-					};
+			/**
+			 * @brief appends the string representation of the value to the end of out. doubles are written
+			 * in the shortest form that reads back to the same double, keeping a ".0" when it has no fraction.
+			 * the decimal form is kept from 1e-5 up to 1e16 (100000.0 rather than 1e+05), only numbers outside
+			 * of that range are written with an exponent
+			 * @param out the string to append to
+			 */
+			void stringify_to(std::string& out) const noexcept
+			{
+				if (this->is_double() || this->is_integer())
+				{
+					char		     buffer[32];
+					std::to_chars_result result;
+					if (this->is_double())
+					{
+						const double number    = std::get<double>(_value);
+						const double magnitude = std::fabs(number);
+						if (magnitude >= 1e-5 && magnitude < 1e16)
+							result = std::to_chars(buffer, buffer + sizeof(buffer), number, std::chars_format::fixed);
+						else
+							result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+					}
+					else
+						result = std::to_chars(buffer, buffer + sizeof(buffer), std::get<int64_t>(_value));
 
-					pop_zeros_at_the_end();
+					assert(result.ec == std::errc());
+					out.append(buffer, result.ptr);
 
-					return str;
-				}
-				else if (this->is_integer())
-				{
-					return std::to_string(std::get<int64_t>(_value));
+					if (this->is_double() && std::isfinite(std::get<double>(_value)) &&
+					    std::find_if(buffer, result.ptr, [](char c) { return c == '.' || c == 'e'; }) == result.ptr)
+						out += ".0";
 				}
 				else if (this->is_string())
 				{
-					return std::get<std::string>(_value);
+					out += std::get<std::string>(_value);
 				}
 				else if (this->is_boolean())
 				{
-					return std::get<bool>(_value) == true ? "true" : "false";
+					out += std::get<bool>(_value) == true ? "true" : "false";
 				}
 				else if (this->is_null())
 				{
-					return "null";
-				}
-				else
-				{
-					return "";
+					out += "null";
 				}
 			}
 
@@ -953,6 +1071,12 @@ namespace ljson {
 			 * @return string name of the value_type
 			 */
 			std::string type_name() const noexcept
+			{
+				return this->type_literal();
+			}
+
+		private:
+			const char* type_literal() const noexcept
 			{
 				if (this->is_string())
 					return "string";
@@ -969,6 +1093,12 @@ namespace ljson {
 				else
 					return "unknown";
 			}
+
+			error cast_error(const char* target) const noexcept
+			{
+				return error(error_type::wrong_type,
+				    error::lazy_message{"wrong type: trying to cast a '{}' value to '{}'", this->type_literal(), target});
+			}
 	};
 
 	class json;
@@ -1032,11 +1162,15 @@ namespace ljson {
 	template<typename value_type>
 	concept container_or_node_type = container_type_concept<value_type> || is_allowed_node_type<value_type>;
 
-	using object_pairs = std::initializer_list<std::pair<std::string, std::any>>;
-	using array_values = std::initializer_list<std::any>;
+	class node_initializer;
 
-	using json_object = std::map<std::string, class node>;
-	using json_array  = std::vector<class node>;
+	using object_pairs = std::initializer_list<std::pair<std::string, node_initializer>>;
+	using array_values = std::initializer_list<node_initializer>;
+
+	class ordered_map;
+
+	using json_object = ordered_map;
+	using json_array  = std::pmr::vector<class node>;
 	using json_node	  = std::variant<std::shared_ptr<class value>, std::shared_ptr<ljson::array>, std::shared_ptr<ljson::object>>;
 
 	/**
@@ -1045,52 +1179,172 @@ namespace ljson {
 	 */
 	class node {
 		private:
-			json_node _node;
+			/**
+			 * @brief what the node holds. null, booleans and numbers are stored inline, strings, arrays and
+			 * objects live in reference counted storage which is shared between copies of the node
+			 */
+			enum class tag : uint8_t {
+				none,
+				null,
+				boolean,
+				integer,
+				double_t,
+				string,
+				array,
+				object,
+			};
 
-		protected:
-			void handle_std_any(const std::any& any_value, std::function<void(std::any)> insert_func);
+			/**
+			 * @brief the reference counted storage of a string, array or object. it is allocated from (and
+			 * returned to) the std::pmr::memory_resource it remembers
+			 */
+			template<typename T>
+			struct shared_storage {
+					std::atomic<uint32_t>	   references = 1;
+					std::pmr::memory_resource* resource;
+					T			   data;
+
+					template<typename... args_t>
+					explicit shared_storage(std::pmr::memory_resource* memory_resource, args_t&&... args)
+					    : resource(memory_resource), data(std::forward<args_t>(args)...)
+					{
+					}
+			};
+
+			union {
+					int64_t				    _integer = 0;
+					double				    _double;
+					bool				    _boolean;
+					shared_storage<std::pmr::string>* _string;
+					shared_storage<ljson::array>*	    _array;
+					shared_storage<ljson::object>*    _object;
+			};
+
+			tag _tag = tag::none;
+
+			template<typename T, typename... args_t>
+			static shared_storage<T>* make_storage(std::pmr::memory_resource* resource, args_t&&... args);
 
-			template<typename is_allowed_node_type>
-			constexpr std::variant<class value, ljson::node> handle_allowed_node_types(
-			    const is_allowed_node_type& value) noexcept;
+			template<typename T>
+			static void release_storage(shared_storage<T>* storage) noexcept;
 
+			void copy_from(const node& other) noexcept;
+			void move_from(node& other) noexcept;
+			void release() noexcept;
+			void reset(tag new_tag, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+			void set_value(const class value& value, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+			void set_string(std::string_view string, std::pmr::memory_resource* resource);
+			class value get_value() const;
+			const char* type_literal() const noexcept;
+			const char* value_type_literal() const noexcept;
+
+			template<typename sink_type>
+			friend class serializer;
+			friend struct parser_syntax;
+
+		protected:
 			template<typename container_or_node_type>
 			constexpr void setting_allowed_node_type(const container_or_node_type& node_value) noexcept;
 
-			template<is_allowed_value_type T>
-			expected<T, error> access_value(std::function<expected<T, error>(std::shared_ptr<class value>)> fun) const;
+			error cast_error(const char* target) const noexcept;
 
 		public:
 			/**
 			 * @brief default constructor which creates ljson::node with type ljson::node_type::object
 			 */
 			explicit node();
+
+			/**
+			 * @brief constructs a node from shared_ptr based storage. the value is copied, arrays and objects
+			 * are copied shallowly (the elements share their storage with the source)
+			 */
 			explicit node(const json_node& n);
 
+			/**
+			 * @brief copy constructor. strings, arrays and objects are shared with other, not copied
+			 */
+			node(const node& other) noexcept;
+			node(node&& other) noexcept;
+			node& operator=(const node& other) noexcept;
+			node& operator=(node&& other) noexcept;
+			~node();
+
 			/**
 			 * @brief constructor to allow setting the type of the ljson::node
 			 * @param type type of node from enum ljson::node_type
 			 */
 			explicit node(enum node_type type);
 
+			/**
+			 * @brief constructor which allocates the storage of the node (and of the arrays, objects and strings
+			 * the parser puts in it) from a std::pmr::memory_resource. the resource has to outlive the node
+			 * @param type type of node from enum ljson::node_type
+			 * @param resource the memory resource to allocate from
+			 */
+			explicit node(enum node_type type, std::pmr::memory_resource* resource);
+
 			template<typename container_or_node_type>
 			explicit node(const container_or_node_type& container) noexcept;
 
-			node(const std::initializer_list<std::pair<std::string, std::any>>& pairs);
-			node(const std::initializer_list<std::any>& val);
+			/**
+			 * @brief constructs an object node from key/value pairs, each value is converted to a node at
+			 * compile time (see ljson::node_initializer)
+			 * @detail @cpp
+			 * ljson::node node = {{"name", "cat"}, {"age", 5u}, {"tags", ljson::node({"smol", "fluffy"})}};
+			 * @ecpp
+			 */
+			node(object_pairs pairs);
+
+			/**
+			 * @brief constructs an array node from values, each value is converted to a node at compile time
+			 */
+			node(array_values values);
 
+			/**
+			 * @brief insert a node, value or std container at key. an rvalue ljson::node is moved in
+			 */
 			template<typename container_or_node_type>
-			expected<class ljson::node, error> insert(const std::string& key, const container_or_node_type& node);
+			expected<class ljson::node, error> insert(std::string_view key, container_or_node_type&& node);
 
+			/**
+			 * @brief append a node, value or std container to an array node. an rvalue ljson::node is moved in
+			 */
 			template<typename container_or_node_type>
-			expected<class ljson::node, error> push_back(const container_or_node_type& node);
+			expected<class ljson::node, error> push_back(container_or_node_type&& node);
+
+			/**
+			 * @brief construct a node at the end of an array node from args, without a temporary node
+			 * @return a reference to the constructed ljson::node
+			 * @throw ljson::error if the node isn't an array
+			 */
+			template<typename... args_t>
+			ljson::node& emplace_back(args_t&&... args);
 
 			/**
-			 * @brief access the ljson::value the ljson::node is holding, if it exists
+			 * @brief make room for size elements in an array node or size keys in an object node
+			 * @param size number of elements or keys
+			 * @throw ljson::error if the node holds a ljson::value
+			 */
+			void reserve(size_t size);
+
+			/**
+			 * @brief get the number of elements or keys the node can hold without reallocating
+			 * @return the capacity, 0 for a node holding a ljson::value
+			 */
+			size_t capacity() const noexcept;
+
+			/**
+			 * @brief release the capacity of an array or object node that isn't used
+			 */
+			void shrink_to_fit();
+
+			/**
+			 * @brief access the ljson::value the ljson::node is holding, if it exists. values are stored inline
+			 * in the node, so this is a read-only copy: use set() or the assignment operators to change the node
 			 * @return ljson::value or ljson::error if it doesn't hold a ljson::value
 			 * @see as_value()
 			 */
-			expected<std::shared_ptr<class value>, error> try_as_value() const noexcept;
+			expected<std::shared_ptr<const class value>, error> try_as_value() const;
 
 			/**
 			 * @brief access the ljson::array the ljson::node is holding, if it exists
@@ -1107,12 +1361,12 @@ namespace ljson {
 			expected<std::shared_ptr<ljson::object>, error> try_as_object() const noexcept;
 
 			/**
-			 * @brief access the ljson::value the ljson::node is holding, if it exists
+			 * @brief access a read-only copy of the ljson::value the ljson::node is holding, if it exists
 			 * @throw ljson::error if it doesn't hold ljson::value
-			 * @return std::shared_ptr<ljson::value>
+			 * @return std::shared_ptr<const ljson::value>
 			 * @see try_as_value()
 			 */
-			std::shared_ptr<class value> as_value() const;
+			std::shared_ptr<const class value> as_value() const;
 
 			/**
 			 * @brief access the ljson::array the ljson::node is holding, if it exists
@@ -1130,6 +1384,38 @@ namespace ljson {
 			 */
 			std::shared_ptr<ljson::object> as_object() const;
 
+			/**
+			 * @brief borrow the ljson::array the ljson::node is holding. unlike try_as_array() it doesn't take a
+			 * reference count, the reference is valid as long as the node holds the array
+			 * @return reference to the ljson::array or ljson::error if it doesn't hold a ljson::array
+			 * @see as_array_ref()
+			 */
+			expected<std::reference_wrapper<ljson::array>, error> try_as_array_ref() const noexcept;
+
+			/**
+			 * @brief borrow the ljson::object the ljson::node is holding. unlike try_as_object() it doesn't take
+			 * a reference count, the reference is valid as long as the node holds the object
+			 * @return reference to the ljson::object or ljson::error if it doesn't hold a ljson::object
+			 * @see as_object_ref()
+			 */
+			expected<std::reference_wrapper<ljson::object>, error> try_as_object_ref() const noexcept;
+
+			/**
+			 * @brief borrow the ljson::array the ljson::node is holding
+			 * @throw ljson::error if it doesn't hold ljson::array
+			 * @return ljson::array&
+			 * @see try_as_array_ref()
+			 */
+			ljson::array& as_array_ref() const;
+
+			/**
+			 * @brief borrow the ljson::object the ljson::node is holding
+			 * @throw ljson::error if it doesn't hold ljson::object
+			 * @return ljson::object&
+			 * @see try_as_object_ref()
+			 */
+			ljson::object& as_object_ref() const;
+
 			/**
 			 * @brief cast a node into a std::string if it is holding ljson::value that is a json string (std::string)
 			 * @detail @cpp
@@ -1150,6 +1436,14 @@ namespace ljson {
 			 */
 			expected<std::string, error> try_as_string() const noexcept;
 
+			/**
+			 * @brief view the json string the node is holding without copying it. the view is valid as long as
+			 * the node (or a copy sharing its string) holds the string
+			 * @return std::string_view or ljson::error if it doesn't hold a string
+			 * @see as_string_view()
+			 */
+			expected<std::string_view, error> try_as_string_view() const noexcept;
+
 			/**
 			 * @brief cast a node into a int64_t if it is holding ljson::value that is a json number (int64_t)
 			 * @return int64_t or ljson::error if it doesn't hold a string
@@ -1206,6 +1500,14 @@ namespace ljson {
 			 */
 			std::string as_string() const;
 
+			/**
+			 * @brief view the json string the node is holding without copying it
+			 * @exception ljson::error if it doesn't hold a ljson::value and string
+			 * @return json string
+			 * @see try_as_string_view()
+			 */
+			std::string_view as_string_view() const;
+
 			/**
 			 * @brief cast a node into a int64_t if it is holding ljson::value that is a json number (int64_t)
 			 * @exception ljson::error if it doesn't hold a ljson::value and int64_t
@@ -1246,6 +1548,28 @@ namespace ljson {
 			 */
 			null_type as_null() const;
 
+			/**
+			 * @brief cast a node holding a ljson::value into T, resolved at compile time. T can be bool, any
+			 * integral or floating point type, std::string, std::string_view or ljson::null_type. integers that
+			 * don't fit in T are an error, floating point types accept integers too
+			 * @detail @cpp
+			 * ljson::expected<uint16_t, error> port = node.at("port").try_get<uint16_t>();
+			 * @ecpp
+			 * @return T or ljson::error if the node doesn't hold a value convertible to T
+			 * @see get()
+			 */
+			template<typename T>
+			expected<T, error> try_get() const noexcept;
+
+			/**
+			 * @brief cast a node holding a ljson::value into T
+			 * @exception ljson::error if the node doesn't hold a value convertible to T
+			 * @return T
+			 * @see try_get()
+			 */
+			template<typename T>
+			T get() const;
+
 			/**
 			 * @brief checks if ljson::node is holding ljson::value
 			 * @return true if it does
@@ -1358,7 +1682,7 @@ namespace ljson {
 			 * @param key key to lookup
 			 * @return true if it does
 			 */
-			bool contains(const std::string& key) const noexcept;
+			bool contains(std::string_view key) const noexcept;
 
 			/**
 			 * @brief access the node at the specified object key
@@ -1366,7 +1690,7 @@ namespace ljson {
 			 * @return ljson::node& at the specified key
 			 * @see try_at()
 			 */
-			class node& at(const std::string& object_key) const;
+			class node& at(std::string_view object_key) const;
 
 			/**
 			 * @brief access the node at the specified array index
@@ -1400,7 +1724,7 @@ namespace ljson {
 			 * @return either std::reference_wrapper<ljson::node> if the node was found or ljson::error if not
 			 * @see at()
 			 */
-			expected<std::reference_wrapper<ljson::node>, ljson::error> try_at(const std::string& object_key) const noexcept;
+			expected<std::reference_wrapper<ljson::node>, ljson::error> try_at(std::string_view object_key) const noexcept;
 
 			/**
 			 * @brief access the node at the specified array index
@@ -1435,6 +1759,12 @@ namespace ljson {
 			template<typename container_or_node_type>
 			void set(const container_or_node_type& node_value) noexcept;
 
+			/**
+			 * @brief set a node by moving another node into it
+			 * @param node_value node to be moved
+			 */
+			void set(ljson::node&& node_value) noexcept;
+
 			/**
 			 * @brief asign a node with a container_or_node_type
 			 * @param node_value value to be set
@@ -1443,8 +1773,8 @@ namespace ljson {
 			template<typename container_or_node_type>
 			class node& operator=(const container_or_node_type& node_value) noexcept;
 
-			class node& operator+=(const std::initializer_list<std::pair<std::string, std::any>>& pairs);
-			class node& operator+=(const std::initializer_list<std::any>& val);
+			class node& operator+=(object_pairs pairs);
+			class node& operator+=(array_values values);
 
 			/**
 			 * @brief add two ljson::node together. they must have the same type and be either object, array, string or number
@@ -1466,8 +1796,23 @@ namespace ljson {
 			 */
 			class node operator+(const node& other_node);
 
-			void dump(const std::function<void(std::string)> out_func, const std::pair<char, int>& indent_conf = {' ', 4},
-			    int indent = 0) const;
+			/**
+			 * @brief write ljson::node through a callable. the json is serialized into a buffer which is handed
+			 * to out_func as a const std::string& whenever it fills up and once at the end
+			 * @param out_func callable invoked with each serialized chunk
+			 * @param indent_conf indentation config for writing {char, size}
+			 * @param indent the indentation of the first line
+			 */
+			template<typename out_func_type>
+			void dump(out_func_type&& out_func, const std::pair<char, int>& indent_conf = {' ', 4}, int indent = 0) const;
+
+			/**
+			 * @brief write ljson::node through a callable using the given style. pretty uses {' ', 4} as indentation
+			 * @param out_func callable invoked with each serialized chunk
+			 * @param style ljson::dump_style::pretty or ljson::dump_style::compact
+			 */
+			template<typename out_func_type>
+			void dump(out_func_type&& out_func, dump_style style) const;
 
 			/**
 			 * @brief write ljson::node to stdout
@@ -1482,6 +1827,13 @@ namespace ljson {
 			 */
 			std::string dump_to_string(const std::pair<char, int>& indent_conf = {' ', 4}) const;
 
+			/**
+			 * @brief write ljson::node to string using the given style
+			 * @param style ljson::dump_style::pretty or ljson::dump_style::compact
+			 * @return json serialized
+			 */
+			std::string dump_to_string(dump_style style) const;
+
 			/**
 			 * @brief write ljson::node to a file
 			 * @param path path to write to
@@ -1490,15 +1842,55 @@ namespace ljson {
 			expected<monostate, error> dump_to_file(
 			    const std::filesystem::path& path, const std::pair<char, int>& indent_conf = {' ', 4}) const;
 
-			expected<class ljson::node, error> add_value_to_key(const std::string& key, const class value& value);
-			expected<class ljson::node, error> add_node_to_key(const std::string& key, const ljson::node& node);
+			/**
+			 * @brief write ljson::node to a file using the given style
+			 * @param path path to write to
+			 * @param style ljson::dump_style::pretty or ljson::dump_style::compact
+			 */
+			expected<monostate, error> dump_to_file(const std::filesystem::path& path, dump_style style) const;
+
+			expected<class ljson::node, error> add_value_to_key(std::string_view key, const class value& value);
+			expected<class ljson::node, error> add_node_to_key(std::string_view key, const ljson::node& node);
+			expected<class ljson::node, error> add_node_to_key(std::string_view key, ljson::node&& node);
 			expected<class ljson::node, error> add_value_to_array(const class value& value);
 			expected<class ljson::node, error> add_value_to_array(const size_t index, const class value& value);
 			expected<class ljson::node, error> add_node_to_array(const ljson::node& node);
+			expected<class ljson::node, error> add_node_to_array(ljson::node&& node);
 			expected<class ljson::node, error> add_node_to_array(const size_t index, const ljson::node& node);
-			expected<class ljson::node, error> add_array_to_key(const std::string& key);
+			expected<class ljson::node, error> add_node_to_array(const size_t index, ljson::node&& node);
+			expected<class ljson::node, error> add_array_to_key(std::string_view key);
 			expected<class ljson::node, error> add_object_to_array();
-			expected<class ljson::node, error> add_object_to_key(const std::string& key);
+			expected<class ljson::node, error> add_object_to_key(std::string_view key);
+	};
+
+	/**
+	 * @class node_initializer
+	 * @brief an element of ljson::object_pairs and ljson::array_values. it converts from any type ljson::node
+	 * accepts (strings, every arithmetic type, bool, null, ljson::value, ljson::node and std containers) and builds
+	 * the node right away, the type is resolved at compile time
+	 */
+	class node_initializer {
+		private:
+			ljson::node _node;
+
+		public:
+			template<container_or_node_type T>
+			node_initializer(const T& value) : _node(value)
+			{
+			}
+
+			node_initializer(const char* value) : _node(value)
+			{
+			}
+
+			node_initializer(std::string_view value) : _node(std::string(value))
+			{
+			}
+
+			const ljson::node& get() const noexcept
+			{
+				return _node;
+			}
 	};
 
 	/**
@@ -1518,11 +1910,31 @@ namespace ljson {
 			{
 			}
 
+			explicit array(std::pmr::memory_resource* resource) noexcept : _array(resource)
+			{
+			}
+
 			void push_back(const class node& element)
 			{
 				return _array.push_back(element);
 			}
 
+			void push_back(class node&& element)
+			{
+				return _array.push_back(std::move(element));
+			}
+
+			/**
+			 * @brief construct a ljson::node in place at the end of the array
+			 * @param args arguments for the ljson::node constructor
+			 * @return a reference to the constructed ljson::node
+			 */
+			template<typename... args_t>
+			class node& emplace_back(args_t&&... args)
+			{
+				return _array.emplace_back(std::forward<args_t>(args)...);
+			}
+
 			void pop_back()
 			{
 				return _array.pop_back();
@@ -1558,6 +1970,21 @@ namespace ljson {
 				return _array.empty();
 			}
 
+			void reserve(size_t size)
+			{
+				_array.reserve(size);
+			}
+
+			size_t capacity() const noexcept
+			{
+				return _array.capacity();
+			}
+
+			void shrink_to_fit()
+			{
+				_array.shrink_to_fit();
+			}
+
 			json_array::iterator begin()
 			{
 				return _array.begin();
@@ -1580,30 +2007,294 @@ namespace ljson {
 	};
 
 	/**
-	 * @class object
-	 * @brief the class that holds a json object
+	 * @class ordered_map
+	 * @brief the key/value container behind ljson::object. entries are stored contiguously in insertion order,
+	 * small objects are searched with a linear scan and a hash index of the keys is kept once an object grows
+	 * past index_threshold entries. keys must not be changed through iterators
 	 */
-	class object {
+	class ordered_map {
+		public:
+			using key_type	      = std::string;
+			using mapped_type     = ljson::node;
+			using value_type      = std::pair<std::string, ljson::node>;
+			using size_type	      = size_t;
+			using entries_type    = std::pmr::vector<value_type>;
+			using iterator	      = entries_type::iterator;
+			using const_iterator  = entries_type::const_iterator;
+
+			static constexpr size_t index_threshold = 16;
+
 		private:
-			json_object _object;
+			entries_type		   _entries;
+			std::pmr::vector<uint32_t> _index;
 
-		public:
-			/**
-			 * @brief constructor for ljson::object
-			 */
-			explicit object() : _object(json_object{})
+			static size_t hash(std::string_view key) noexcept
 			{
+				return std::hash<std::string_view>{}(key);
 			}
 
-			/**
-			 * @brief insert ljson::node into key
-			 * @param key the json key to insert at
-			 * @param element the ljson::node to be inserted
-			 * @return a reference of the inserted ljson::node
-			 */
-			ljson::node& insert(const std::string& key, const class node& element)
+			size_t position(std::string_view key) const noexcept
 			{
-				return _object[key] = element;
+				if (_index.empty())
+				{
+					for (size_t i = 0; i < _entries.size(); i++)
+					{
+						if (_entries[i].first == key)
+							return i;
+					}
+					return _entries.size();
+				}
+
+				const size_t mask = _index.size() - 1;
+				for (size_t slot = hash(key) & mask; _index[slot] != 0; slot = (slot + 1) & mask)
+				{
+					if (_entries[_index[slot] - 1].first == key)
+						return _index[slot] - 1;
+				}
+
+				return _entries.size();
+			}
+
+			void index_entry(size_t i) noexcept
+			{
+				const size_t mask = _index.size() - 1;
+				size_t	     slot = hash(_entries[i].first) & mask;
+				while (_index[slot] != 0)
+					slot = (slot + 1) & mask;
+				_index[slot] = static_cast<uint32_t>(i + 1);
+			}
+
+			void rebuild_index()
+			{
+				_index.clear();
+				if (_entries.size() <= index_threshold)
+					return;
+
+				_index.resize(std::bit_ceil(_entries.size() * 2));
+				for (size_t i = 0; i < _entries.size(); i++)
+					this->index_entry(i);
+			}
+
+			template<typename... args_t>
+			iterator append(std::string_view key, args_t&&... args)
+			{
+				_entries.emplace_back(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<args_t>(args)...));
+				if (_entries.size() > index_threshold)
+				{
+					if (_index.size() < _entries.size() * 2)
+						this->rebuild_index();
+					else
+						this->index_entry(_entries.size() - 1);
+				}
+
+				return _entries.end() - 1;
+			}
+
+		public:
+			explicit ordered_map(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+			    : _entries(resource), _index(resource)
+			{
+			}
+
+			iterator find(std::string_view key) noexcept
+			{
+				return _entries.begin() + static_cast<std::ptrdiff_t>(this->position(key));
+			}
+
+			const_iterator find(std::string_view key) const noexcept
+			{
+				return _entries.begin() + static_cast<std::ptrdiff_t>(this->position(key));
+			}
+
+			bool contains(std::string_view key) const noexcept
+			{
+				return this->position(key) != _entries.size();
+			}
+
+			ljson::node& at(std::string_view key)
+			{
+				size_t i = this->position(key);
+				if (i == _entries.size())
+					throw std::out_of_range("ljson::ordered_map::at");
+
+				return _entries[i].second;
+			}
+
+			/**
+			 * @brief inserts element at key, an existing key keeps its position and gets the new element
+			 * @return iterator to the entry and true if the key was new
+			 */
+			template<typename node_type>
+			std::pair<iterator, bool> insert_or_assign(std::string_view key, node_type&& element)
+			{
+				iterator itr = this->find(key);
+				if (itr != _entries.end())
+				{
+					itr->second = std::forward<node_type>(element);
+					return {itr, false};
+				}
+
+				return {this->append(key, std::forward<node_type>(element)), true};
+			}
+
+			/**
+			 * @brief constructs a node in place from args if key doesn't exist yet, otherwise does nothing
+			 * @return iterator to the entry and true if the key was new
+			 */
+			template<typename... args_t>
+			std::pair<iterator, bool> try_emplace(std::string_view key, args_t&&... args)
+			{
+				iterator itr = this->find(key);
+				if (itr != _entries.end())
+					return {itr, false};
+
+				return {this->append(key, std::forward<args_t>(args)...), true};
+			}
+
+			ljson::node& operator[](std::string_view key)
+			{
+				iterator itr = this->find(key);
+				if (itr != _entries.end())
+					return itr->second;
+
+				return this->append(key)->second;
+			}
+
+			size_type erase(std::string_view key)
+			{
+				iterator itr = this->find(key);
+				if (itr == _entries.end())
+					return 0;
+
+				this->erase(itr);
+				return 1;
+			}
+
+			iterator erase(const_iterator pos)
+			{
+				return this->erase(pos, pos + 1);
+			}
+
+			iterator erase(const_iterator first, const_iterator last)
+			{
+				iterator itr = _entries.erase(first, last);
+				if (not _index.empty())
+					this->rebuild_index();
+
+				return itr;
+			}
+
+			void reserve(size_type size)
+			{
+				_entries.reserve(size);
+				if (size > index_threshold)
+					_index.reserve(std::bit_ceil(size * 2));
+			}
+
+			size_type capacity() const noexcept
+			{
+				return _entries.capacity();
+			}
+
+			void shrink_to_fit()
+			{
+				_entries.shrink_to_fit();
+				_index.shrink_to_fit();
+			}
+
+			void clear() noexcept
+			{
+				_entries.clear();
+				_index.clear();
+			}
+
+			size_type size() const noexcept
+			{
+				return _entries.size();
+			}
+
+			bool empty() const noexcept
+			{
+				return _entries.empty();
+			}
+
+			iterator begin() noexcept
+			{
+				return _entries.begin();
+			}
+
+			iterator end() noexcept
+			{
+				return _entries.end();
+			}
+
+			const_iterator begin() const noexcept
+			{
+				return _entries.begin();
+			}
+
+			const_iterator end() const noexcept
+			{
+				return _entries.end();
+			}
+	};
+
+	/**
+	 * @class object
+	 * @brief the class that holds a json object. keys keep the order they were inserted in
+	 */
+	class object {
+		private:
+			json_object _object;
+
+		public:
+			/**
+			 * @brief constructor for ljson::object
+			 */
+			explicit object() : _object(json_object{})
+			{
+			}
+
+			/**
+			 * @brief constructor for ljson::object which allocates its keys' nodes from resource
+			 */
+			explicit object(std::pmr::memory_resource* resource) : _object(resource)
+			{
+			}
+
+			/**
+			 * @brief insert ljson::node into key
+			 * @param key the json key to insert at
+			 * @param element the ljson::node to be inserted
+			 * @return a reference of the inserted ljson::node
+			 */
+			ljson::node& insert(std::string_view key, const class node& element)
+			{
+				return _object.insert_or_assign(key, element).first->second;
+			}
+
+			/**
+			 * @brief move ljson::node into key
+			 * @param key the json key to insert at
+			 * @param element the ljson::node to be moved in
+			 * @return a reference of the inserted ljson::node
+			 */
+			ljson::node& insert(std::string_view key, class node&& element)
+			{
+				return _object.insert_or_assign(key, std::move(element)).first->second;
+			}
+
+			/**
+			 * @brief construct a ljson::node in place at key if the key doesn't exist yet
+			 * @param key the json key to insert at
+			 * @param args arguments for the ljson::node constructor
+			 * @return a reference of the ljson::node at key and true if it was constructed
+			 */
+			template<typename... args_t>
+			std::pair<std::reference_wrapper<ljson::node>, bool> emplace(std::string_view key, args_t&&... args)
+			{
+				auto [itr, inserted] = _object.try_emplace(key, std::forward<args_t>(args)...);
+				return {std::ref(itr->second), inserted};
 			}
 
 			/**
@@ -1611,7 +2302,7 @@ namespace ljson {
 			 * @param key the json key to be removed
 			 * @return number of keys removed
 			 */
-			json_object::size_type erase(const std::string& key)
+			json_object::size_type erase(std::string_view key)
 			{
 				return _object.erase(key);
 			}
@@ -1655,15 +2346,50 @@ namespace ljson {
 				return _object.empty();
 			}
 
+			/**
+			 * @brief make room for size keys without reallocating
+			 * @param size number of keys
+			 */
+			void reserve(size_t size)
+			{
+				_object.reserve(size);
+			}
+
+			/**
+			 * @brief get the number of keys the ljson::object can hold without reallocating
+			 * @return the capacity
+			 */
+			size_t capacity() const noexcept
+			{
+				return _object.capacity();
+			}
+
+			/**
+			 * @brief release the capacity that isn't used by keys
+			 */
+			void shrink_to_fit()
+			{
+				_object.shrink_to_fit();
+			}
+
 			/**
 			 * @brief find a key
 			 * @return iterator of the found key found or end()
 			 */
-			json_object::iterator find(const std::string& key)
+			json_object::iterator find(std::string_view key)
 			{
 				return _object.find(key);
 			}
 
+			/**
+			 * @brief check if the ljson::object has a key
+			 * @return true if it has
+			 */
+			bool contains(std::string_view key) const noexcept
+			{
+				return _object.contains(key);
+			}
+
 			/**
 			 * @brief returns an the first iterator
 			 * @return the first iterator
@@ -1688,7 +2414,7 @@ namespace ljson {
 			 * @return a reference to the ljson::node associated to the key
 			 * @throw std::out_of_range if the container doesn't have the key
 			 */
-			class ljson::node& at(const std::string& key)
+			class ljson::node& at(std::string_view key)
 			{
 				return _object.at(key);
 			}
@@ -1698,1879 +2424,4517 @@ namespace ljson {
 			 * @param key to be accessed
 			 * @return a reference to the ljson::node associated to the key
 			 */
-			class ljson::node& operator[](const std::string& key)
+			class ljson::node& operator[](std::string_view key)
 			{
 				return _object[key];
 			}
 	};
 
-	class parser {
+	/**
+	 * @enum simd_type
+	 * @brief instruction sets ljson::structural_index can scan the input with
+	 */
+	enum class simd_type {
+		scalar,
+		sse2,
+		avx2,
+		neon,
+	};
+
+	/**
+	 * @class structural_index
+	 * @brief the first parsing stage. it scans the input 64 bytes at a time and records the positions of the
+	 * structural characters ({}[]:,) and unescaped quotes outside of strings, and the first character of every
+	 * number/literal. the parser then jumps between these positions instead of testing every byte
+	 */
+	class structural_index {
 		private:
-			static bool			  done_or_not_ok(const expected<bool, error>& ok);
-			static expected<monostate, error> return_error_if_not_ok(const expected<bool, error>& ok);
-			static expected<monostate, error> check_unhandled_hierarchy(const std::string& raw_json, struct parsing_data& data);
-			static expected<monostate, error> parsing(struct parsing_data& data);
+			struct block_masks {
+					uint64_t quote	    = 0;
+					uint64_t backslash  = 0;
+					uint64_t structural = 0;
+					uint64_t empty	    = 0;
+			};
 
-		public:
-			explicit parser();
-			~parser();
-			static ljson::node		    parse(const std::filesystem::path& path);
-			static ljson::node		    parse(const std::string& raw_json);
-			static ljson::node		    parse(const char* raw_json);
-			static expected<ljson::node, error> try_parse(const std::filesystem::path& path) noexcept;
-			static expected<ljson::node, error> try_parse(const std::string& raw_json) noexcept;
-			static expected<ljson::node, error> try_parse(const char* raw_json) noexcept;
-	};
-}
+			std::vector<uint32_t> _positions;
 
-namespace ljson {
-	struct parsing_data {
-			std::string				     line;
-			size_t					     i		 = 0;
-			size_t					     line_number = 1;
-			std::stack<std::pair<std::string, key_type>> keys;
-			std::stack<ljson::node>			     json_objs;
-			std::pair<std::string, value_type>	     raw_value;
-			class value				     value;
-			std::stack<std::pair<json_syntax, size_t>>   hierarchy;
-	};
+			static block_masks classify_scalar(const char* block) noexcept;
+#if defined(LJSON_X86_64)
+			static block_masks classify_sse2(const char* block) noexcept;
+			LJSON_TARGET_AVX2 static block_masks classify_avx2(const char* block) noexcept;
+#elif defined(LJSON_ARM64)
+			static block_masks classify_neon(const char* block) noexcept;
+#endif
 
-	struct parser_syntax {
-			struct open_bracket {
-					static expected<bool, error> handle_open_bracket(struct parsing_data& data)
-					{
-						if (data.line[data.i] == '{' && not value::is_string(data))
-						{
-							data.hierarchy.push({json_syntax::opening_bracket, data.line_number});
-							return true;
-						}
+			static uint64_t escaped_chars(uint64_t backslash, uint64_t& prev_escaped) noexcept;
+			static uint64_t prefix_xor(uint64_t bits) noexcept;
 
-						return false;
-					}
-			};
+			template<block_masks (*classify)(const char*) noexcept>
+			void scan(std::string_view raw_json);
 
-			struct empty {
-					static expected<bool, error> handle_empty(struct parsing_data& data)
-					{
-						if (data.line[data.i] != ' ' && data.line[data.i] != '\t')
-							return false;
-						else if (data.hierarchy.empty())
-							return true;
-						else if (quotes::is_hierarchy_qoutes(data.hierarchy))
-							return false;
-						else if (data.hierarchy.top().first == json_syntax::string_value)
-							return false;
-						else if (data.raw_value.second != ljson::value_type::none &&
-							 data.raw_value.second != ljson::value_type::unknown)
-							return false;
-						else if (data.raw_value.second != ljson::value_type::string &&
-							 not data.raw_value.first.empty())
-						{
-							auto ok = end_statement::flush_value(data);
-							if (not ok && ok.error().value() == error_type::parsing_error_wrong_type)
-								return unexpected(error(error_type::parsing_error,
-								    "reached an empty-space on non-string unknown type: " +
-									data.raw_value.first));
-							else
-								return ok;
-						}
+		public:
+			/**
+			 * @brief the biggest input that can be indexed
+			 */
+			static constexpr size_t max_size = UINT32_MAX;
 
-						return true;
-					}
-			};
+			/**
+			 * @brief detects the fastest instruction set supported by the running cpu
+			 * @return simd_type
+			 */
+			static simd_type best_simd_type() noexcept;
 
-			struct key {
-					static expected<bool, error> handle_key(struct parsing_data& data)
-					{
-						if (quotes::is_hierarchy_qoutes(data.hierarchy) && not array::is_array(data))
-						{
-							data.keys.top().first += data.line[data.i];
-							return true;
-						}
+			/**
+			 * @brief checks if the running cpu supports an instruction set
+			 * @param type instruction set to check
+			 * @return true if it does
+			 */
+			static bool is_supported(simd_type type) noexcept;
 
-						return false;
-					}
-			};
+			/**
+			 * @brief index the input. every instruction set produces the same positions
+			 * @param raw_json json text, at most max_size bytes
+			 * @param type instruction set to scan with, falls back to simd_type::scalar if it's not supported
+			 */
+			void build(std::string_view raw_json, simd_type type = best_simd_type());
 
-			struct quotes {
-					static expected<bool, error> handle_quotes(struct parsing_data& data)
-					{
-						bool found_qoute = false;
-						if (quote(data))
-						{
-							if (data.hierarchy.top().first == json_syntax::quotes_1)
-							{
-								if (not data.keys.empty() && data.keys.top().first.empty())
-									data.keys.top().second = key_type::simple_key;
-								data.hierarchy.pop();
-								return true;
-							}
+			/**
+			 * @brief the indexed positions in increasing order
+			 * @return the indexed positions
+			 */
+			const std::vector<uint32_t>& positions() const noexcept;
+	};
 
-							found_qoute = true;
-						}
+	/**
+	 * @class file_buffer
+	 * @brief read-only view of the content of a file. regular files are memory mapped on posix systems, everything
+	 * else (pipes, special files, other platforms) is read into an owned buffer
+	 */
+	class file_buffer {
+		private:
+			std::string _buffer;
+			const char* _mapped = nullptr;
+			size_t	    _size   = 0;
 
-						if (found_qoute)
-						{
-							if (not data.hierarchy.empty() &&
-							    (data.hierarchy.top().first == json_syntax::column ||
-								data.hierarchy.top().first == json_syntax::array))
-							{
-								data.hierarchy.push({json_syntax::string_value, data.line_number});
-								data.raw_value.second = ljson::value_type::string;
-							}
-							else if (not data.hierarchy.empty() &&
-								 data.hierarchy.top().first == json_syntax::string_value)
-							{
-								data.hierarchy.pop();
-								return end_statement::flush_value(data);
-							}
-							else
-								data.hierarchy.push({json_syntax::quotes_1, data.line_number});
+#if defined(__unix__) || defined(__APPLE__)
+			expected<monostate, error> read_fd(int fd, size_t size_hint);
+#endif
 
-							return true;
-						}
+		public:
+			explicit file_buffer() noexcept = default;
+			file_buffer(const file_buffer&)		   = delete;
+			file_buffer& operator=(const file_buffer&) = delete;
+			~file_buffer();
 
-						return false;
-					}
+			/**
+			 * @brief map or read the file at path
+			 * @param path path of the file
+			 * @return ljson::monostate or ljson::error of type filesystem_error
+			 */
+			expected<monostate, error> open(const std::filesystem::path& path);
 
-					static bool quote(const struct parsing_data& data)
-					{
-						if (data.line[data.i] == '"' && data.raw_value.second != value_type::temp_escape_type)
-							return true;
-						else
-							return false;
-					}
+			/**
+			 * @brief the content of the file, valid for the lifetime of the file_buffer
+			 * @return the content of the file
+			 */
+			std::string_view view() const noexcept;
 
-					static bool is_hierarchy_qoutes(const std::stack<std::pair<json_syntax, size_t>>& hierarchy)
-					{
-						if (hierarchy.empty())
-							return false;
-						else if (hierarchy.top().first == json_syntax::quotes_1)
-							return true;
-						else
-							return false;
-					}
-
-					static bool is_hierarchy_qoutes(const char ch)
-					{
-						if (ch == '"' || ch == '\'')
-							return true;
-						else
-							return false;
-					}
-			};
+			/**
+			 * @brief checks if the content is memory mapped
+			 * @return true if it is
+			 */
+			bool is_mapped() const noexcept;
+	};
 
-			struct array {
-					static expected<bool, error> handle_array(struct parsing_data& data)
-					{
-						if (data.hierarchy.empty() || end_statement::is_end_statement(data) ||
-						    value::is_string(data))
-							return false;
+	/**
+	 * @struct sax_handler
+	 * @brief the events ljson::parser::try_parse_events() reports, every one of them does nothing. derive from it
+	 * and hide the events you need. the handler is a template parameter so the events are resolved at compile
+	 * time, returning false from an event stops the parser with error_type::parsing_stopped. keys and strings are
+	 * views into the input and are kept as written (escape sequences aren't decoded)
+	 * @detail @cpp
+	 * struct sum_handler : ljson::sax_handler {
+	 *	int64_t sum = 0;
+	 *
+	 *	bool on_integer(int64_t number)
+	 *	{
+	 *		sum += number;
+	 *		return true;
+	 *	}
+	 * };
+	 *
+	 * sum_handler handler;
+	 * auto ok = ljson::parser::try_parse_events(raw_json, handler);
+	 * @ecpp
+	 */
+	struct sax_handler {
+			bool on_object_start()
+			{
+				return true;
+			}
 
-						if (data.line[data.i] == '[')
-						{
-							data.hierarchy.push({json_syntax::array, data.line_number});
-							data.keys.top().second = key_type::array;
+			bool on_object_end()
+			{
+				return true;
+			}
 
-							auto ok = data.json_objs.top().add_array_to_key(data.keys.top().first);
-							if (not ok)
-								return unexpected(ok.error());
-							data.json_objs.push(ok.value());
+			bool on_array_start()
+			{
+				return true;
+			}
 
-							if (end_statement::next_char_is_newline(data))
-								data.line.pop_back();
-							return true;
-						}
-						else if (is_array(data) && data.line[data.i] == ']')
-						{
-							data.hierarchy.pop();
+			bool on_array_end()
+			{
+				return true;
+			}
 
-							if (not data.json_objs.empty())
-								data.json_objs.pop();
+			bool on_key(std::string_view)
+			{
+				return true;
+			}
 
-							data.hierarchy.push({json_syntax::maybe_empty_space_after, data.line_number});
+			bool on_string(std::string_view)
+			{
+				return true;
+			}
 
-							return true;
-						}
+			bool on_integer(int64_t)
+			{
+				return true;
+			}
 
-						return false;
-					}
+			bool on_double(double)
+			{
+				return true;
+			}
 
-					static bool is_array(const struct parsing_data& data)
-					{
-						if (not data.json_objs.empty() && data.json_objs.top().type() == node_type::array)
-							return true;
-						return false;
-					}
+			bool on_boolean(bool)
+			{
+				return true;
+			}
 
-					static bool is_array_char(const char ch)
-					{
-						if (ch == '[' || ch == ']')
-							return true;
-						return false;
-					}
+			bool on_null()
+			{
+				return true;
+			}
+	};
 
-					static bool brackets_at_end_of_line(const struct parsing_data& data)
-					{
-						if (data.i == data.line.size() - 1 &&
-						    (data.line[data.i] == '[' || data.line[data.i] == ']'))
-							return true;
-						return false;
-					}
-			};
+	class parser {
+		private:
+			/**
+			 * @brief runs the grammar from the cursor until the handler got one event
+			 * @return true if an event was reported, false at the end of the input or after the root closed
+			 */
+			template<typename handler_type>
+			static expected<bool, error> next_event(struct parsing_data& data, handler_type& handler);
 
-			struct column {
-					static expected<bool, error> handle_column(struct parsing_data& data)
-					{
-						if (data.line[data.i] != ':')
-							return false;
-						else if (column_in_quotes(data.hierarchy))
-							return false;
+			template<typename handler_type>
+			static expected<monostate, error> parsing(struct parsing_data& data, handler_type& handler);
 
-						if (two_consecutive_columns(data.hierarchy))
-						{
-							return unexpected(error(error_type::parsing_error,
-							    std::format("two consecutive columns at: {}, key: {}, val: {}, line: {}",
-								data.line_number, data.keys.top().first, data.raw_value.first, data.line)));
-						}
-						else
-						{
-							data.hierarchy.push({json_syntax::column, data.line_number});
-						}
+			/**
+			 * @brief parses data.raw_json into a ljson::node tree allocated from data.resource
+			 */
+			static expected<ljson::node, error> parse_tree(struct parsing_data& data) noexcept;
 
-						return true;
-					}
+			/**
+			 * @brief parses one chunk of the elements of an array into array, for try_parse_parallel()
+			 */
+			static expected<monostate, error> parse_elements(std::string_view raw_json, const structural_index& index,
+			    const struct array_chunk& chunk, bool first, ljson::node& array) noexcept;
 
-					static bool column_in_quotes(const std::stack<std::pair<json_syntax, size_t>>& hierarchy)
-					{
-						if (hierarchy.empty())
-							return false;
-						else if (hierarchy.top().first == json_syntax::quotes_1 ||
-							 hierarchy.top().first == json_syntax::string_value)
-							return true;
-						return false;
-					}
+			friend class reader;
+			friend class stream_parser;
+			friend class ndjson;
 
-					static bool two_consecutive_columns(const std::stack<std::pair<json_syntax, size_t>>& hierarchy)
-					{
-						if (not hierarchy.empty() && hierarchy.top().first == json_syntax::column)
-							return true;
-						return false;
-					}
-			};
+		public:
+			explicit parser();
+			~parser();
+			static ljson::node		    parse(const std::filesystem::path& path);
+			static ljson::node		    parse(const std::string& raw_json);
+			static ljson::node		    parse(const char* raw_json);
+			static ljson::node		    parse(std::string_view raw_json);
+			static ljson::node		    parse(std::span<const std::byte> raw_json);
+			static expected<ljson::node, error> try_parse(const std::filesystem::path& path) noexcept;
+			static expected<ljson::node, error> try_parse(const std::string& raw_json) noexcept;
+			static expected<ljson::node, error> try_parse(const char* raw_json) noexcept;
 
-			struct object {
-					static expected<bool, error> handle_object(struct parsing_data& data)
-					{
-						if (data.hierarchy.empty() || end_statement::is_end_statement(data) ||
-						    value::is_string(data))
-							return false;
+			/**
+			 * @brief parse json in place from a buffer that doesn't need to be null-terminated. the input is never
+			 * copied
+			 * @param raw_json view of the json text
+			 * @return ljson::node or ljson::error if the json is invalid
+			 */
+			static expected<ljson::node, error> try_parse(std::string_view raw_json) noexcept;
 
-						if (data.line[data.i] == '{')
-						{
-							if (array::is_array(data))
-							{
-								auto ok = data.json_objs.top().add_object_to_array();
-								if (not ok)
-									return unexpected(ok.error());
-								data.json_objs.push(ok.value());
-							}
-							else
-							{
-								auto ok = data.json_objs.top().add_object_to_key(data.keys.top().first);
-								if (not ok)
-									return unexpected(ok.error());
-								data.json_objs.push(ok.value());
-							}
+			/**
+			 * @brief parse json in place from raw bytes, e.g a view into a network receive buffer
+			 * @param raw_json bytes of the json text
+			 * @return ljson::node or ljson::error if the json is invalid
+			 */
+			static expected<ljson::node, error> try_parse(std::span<const std::byte> raw_json) noexcept;
 
-							data.keys.push({"", key_type::simple_key});
-							data.hierarchy.push({json_syntax::object, data.line_number});
+			/**
+			 * @brief parse json allocating every node, string, array and object from resource, e.g a
+			 * std::pmr::monotonic_buffer_resource so the whole tree lives in a few large blocks. the resource has
+			 * to outlive the returned ljson::node and every node taken from it
+			 * @param raw_json view of the json text
+			 * @param resource the memory resource to allocate from
+			 * @return ljson::node or ljson::error if the json is invalid
+			 * @see ljson::document
+			 */
+			static expected<ljson::node, error> try_parse(std::string_view raw_json, std::pmr::memory_resource* resource) noexcept;
+			static ljson::node		    parse(std::string_view raw_json, std::pmr::memory_resource* resource);
 
-							return true;
-						}
-						else if (is_object(data) && data.line[data.i] == '}')
-						{
-							data.hierarchy.pop();
-							data.keys.pop();
+			/**
+			 * @brief parse json and report it to handler as events instead of building a ljson::node tree. no
+			 * nodes are allocated, the input is checked with the same rules as try_parse()
+			 * @param raw_json view of the json text
+			 * @param handler the event handler, see ljson::sax_handler
+			 * @return ljson::monostate or ljson::error if the json is invalid or the handler stopped the parser
+			 */
+			template<typename handler_type>
+			static expected<monostate, error> try_parse_events(std::string_view raw_json, handler_type& handler);
 
-							if (end_statement::end_of_line_after_bracket(data))
-								data.hierarchy.pop();
+			/**
+			 * @brief same as try_parse_events(std::string_view, handler_type&) for a file, which is memory mapped
+			 * when possible instead of read into memory
+			 */
+			template<typename handler_type>
+			static expected<monostate, error> try_parse_events(const std::filesystem::path& path, handler_type& handler);
 
-							if (not data.json_objs.empty())
-								data.json_objs.pop();
+			template<typename handler_type>
+			static expected<monostate, error> try_parse_events(const std::string& raw_json, handler_type& handler);
 
-							if (not data.keys.empty())
-								data.keys.top().second = key_type::none;
-							data.hierarchy.push({json_syntax::maybe_empty_space_after, data.line_number});
-							return true;
-						}
-						else if (array::is_array(data) && data.line[data.i] == '}')
-						{
-							data.hierarchy.pop();
-							data.keys.pop();
-							if (not data.json_objs.empty())
-								data.json_objs.pop();
-							data.hierarchy.push({json_syntax::maybe_empty_space_after, data.line_number});
-							return true;
-						}
+			template<typename handler_type>
+			static expected<monostate, error> try_parse_events(const char* raw_json, handler_type& handler);
 
-						return false;
-					}
+			/**
+			 * @brief same as try_parse_events() but throws
+			 * @throw ljson::error if the json is invalid or the handler stopped the parser
+			 */
+			template<typename handler_type>
+			static void parse_events(std::string_view raw_json, handler_type& handler);
 
-					static bool is_object(const struct parsing_data& data)
-					{
-						if (data.json_objs.empty() || data.json_objs.size() == 1)
-							return false;
-						else if (data.json_objs.top().type() == node_type::object)
-							return true;
-						return false;
-					}
+			/**
+			 * @brief checks that the input is valid json with the same rules as try_parse() without building
+			 * anything. nothing is allocated unless the input is nested deeper than 256 levels
+			 * @param raw_json view of the json text
+			 * @return ljson::monostate or ljson::error with the line and the offset of the problem
+			 */
+			static expected<monostate, error> validate(std::string_view raw_json) noexcept;
 
-					static bool is_object_char(const char ch)
-					{
-						if (ch == '{' || ch == '}')
-							return true;
-						return false;
-					}
+			/**
+			 * @brief arrays smaller than this are never split between threads by try_parse_parallel()
+			 */
+			static constexpr size_t min_parallel_size = 1024 * 1024;
 
-					static bool brackets_at_end_of_line(const struct parsing_data& data)
-					{
-						if (data.i == data.line.size() - 1 &&
-						    (data.line[data.i] == '{' || data.line[data.i] == '}'))
-							return true;
-						return false;
-					}
-			};
+			/**
+			 * @brief parse a large document on several threads. the largest array of the document is cut into
+			 * chunks of whole elements with the structural index, the chunks are parsed on worker threads while
+			 * the rest of the document is parsed on the calling thread, then the elements are joined in order.
+			 * documents without an array of at least min_parallel_size bytes are parsed like try_parse()
+			 * @param raw_json view of the json text
+			 * @param threads the number of worker threads, 0 uses std::thread::hardware_concurrency()
+			 * @return ljson::node or ljson::error if the json is invalid
+			 */
+			static expected<ljson::node, error> try_parse_parallel(std::string_view raw_json, size_t threads = 0);
+			static expected<ljson::node, error> try_parse_parallel(const std::filesystem::path& path, size_t threads = 0);
+			static expected<ljson::node, error> try_parse_parallel(const std::string& raw_json, size_t threads = 0);
+			static expected<ljson::node, error> try_parse_parallel(const char* raw_json, size_t threads = 0);
 
-			struct escape {
-					static expected<bool, error> handle_escape_char(struct parsing_data& data)
-					{
-						if (data.raw_value.second != value_type::temp_escape_type)
-							return false;
+			/**
+			 * @brief same as try_parse_parallel() but throws
+			 * @throw ljson::error if the json is invalid
+			 */
+			static ljson::node parse_parallel(std::string_view raw_json, size_t threads = 0);
+			static ljson::node parse_parallel(const std::filesystem::path& path, size_t threads = 0);
+			static ljson::node parse_parallel(const std::string& raw_json, size_t threads = 0);
+			static ljson::node parse_parallel(const char* raw_json, size_t threads = 0);
+	};
 
-						if (not is_next_char_correct(data.line[data.i]))
-						{
-							std::string err = std::format("escape sequence is incorrect. expected [\", \\, "
-										      "t, b, f, n, r, u, /] found: {}\nline: {}",
-							    data.line[data.i], data.line);
-							return unexpected(error(error_type::parsing_error, err));
-						}
+	/**
+	 * @brief the kind of a ljson::token
+	 */
+	enum class token_type {
+		start_object,
+		end_object,
+		start_array,
+		end_array,
+		key,
+		string,
+		number,
+		boolean,
+		null,
+		end,
+	};
 
-						return true;
-					}
+	/**
+	 * @struct token
+	 * @brief one token of a json document read by ljson::reader. the text is a view into the input: the bracket
+	 * of a container, the content of a key or string as written (escape sequences aren't decoded) or a literal
+	 */
+	struct token {
+			token_type	 type = token_type::end;
+			std::string_view text;
 
-					static bool is_escape_char(const struct parsing_data& data)
-					{
-						if (data.raw_value.second == value_type::string && data.line[data.i] == '\\')
-						{
-							return true;
-						}
-						else
-							return false;
-					}
+			/**
+			 * @brief converts a number token
+			 * @return the integer or ljson::error if the token isn't an integer or doesn't fit in int64_t
+			 */
+			expected<int64_t, error> try_as_integer() const noexcept;
 
-					static bool is_next_char_correct(const char ch)
-					{
-						std::unordered_set<char> chars = {'"', '\\', 't', 'b', 'f', 'n', 'r', 'u', '/'};
-						// TODO: handle the unicode sequence
-						if (auto itr = chars.find(ch); itr != chars.end())
-							return true;
-						else
-							return false;
-					}
-			};
+			/**
+			 * @brief converts a number token, integers are converted too
+			 * @return the double or ljson::error if the token isn't a number
+			 */
+			expected<double, error> try_as_double() const noexcept;
+			int64_t			as_integer() const;
+			double			as_double() const;
+	};
 
-			struct value {
-					static expected<bool, error> handle_value(struct parsing_data& data)
-					{
-						if (data.hierarchy.empty())
-							return false;
-						else if (is_not_value(data))
-							return false;
-						else if (object::is_object_char(data.line[data.i]) && not value::is_string(data))
-							return false;
-						else if (array::is_array_char(data.line[data.i]) && not value::is_string(data))
-							return false;
-						else if (end_statement::is_end_statement(data))
-							return false;
+	/**
+	 * @class reader
+	 * @brief reads a json document one token at a time without building a ljson::node tree. the input is checked
+	 * with the same rules as ljson::parser and has to outlive the reader
+	 * @detail @cpp
+	 * ljson::reader reader(raw_json);
+	 * for (ljson::token token = reader.next(); token.type != ljson::token_type::end; token = reader.next())
+	 * {
+	 *	if (token.type == ljson::token_type::key && token.text == "id")
+	 *		id = reader.next().as_integer();
+	 *	else if (token.type == ljson::token_type::key)
+	 *		reader.skip();
+	 * }
+	 * @ecpp
+	 */
+	class reader {
+		private:
+			std::unique_ptr<struct parsing_data> _data;
 
-						if (empty_value_in_non_string(data))
-							return end_statement::flush_value(data);
+		public:
+			explicit reader(std::string_view raw_json);
+			reader(reader&& other) noexcept;
+			reader& operator=(reader&& other) noexcept;
+			~reader();
 
-						if (not array::is_array(data))
-						{
-							data.keys.top().second = key_type::simple_key;
-						}
+			/**
+			 * @brief reads the next token, after the root object closed every call returns token_type::end
+			 * @return ljson::token or ljson::error if the json is invalid
+			 */
+			expected<ljson::token, error> try_next() noexcept;
 
-						if (escape::is_escape_char(data))
-						{
-							data.raw_value.second = value_type::temp_escape_type;
-						}
-						else if (auto ok = escape::handle_escape_char(data); (ok && ok.value()) || not ok)
-						{
-							if (not ok)
-								return ok;
-							data.raw_value.second = value_type::string;
-						}
-						else
-						{
-							if (data.hierarchy.top().first == json_syntax::string_value)
-							{
-								data.raw_value.second = value_type::string;
-							}
-						}
+			/**
+			 * @brief same as try_next() but throws
+			 * @throw ljson::error if the json is invalid
+			 */
+			ljson::token next();
 
-						data.raw_value.first += data.line[data.i];
+			/**
+			 * @brief skips the next value without reporting its tokens, if the next token is a key the key and
+			 * its value are skipped. the inside of a skipped object or array is only checked for balanced
+			 * brackets and closed strings, which lets it be skipped with a plain scan
+			 * @return ljson::monostate, ljson::error if the json is invalid or ljson::error of type wrong_type if
+			 * the next token closes an object or array, the bracket is left for try_next() then
+			 */
+			expected<monostate, error> try_skip() noexcept;
 
-						return true;
-					}
+			/**
+			 * @brief same as try_skip() but throws
+			 * @throw ljson::error if the json is invalid
+			 */
+			void skip();
 
-					static bool empty_value_in_non_string(const struct parsing_data& data)
-					{
-						if (data.raw_value.first.empty())
-							return false;
-						else if (data.raw_value.second != ljson::value_type::string &&
-							 (data.raw_value.first.back() == ' ' || data.raw_value.first.back() == '\t'))
-							return true;
-						else
-							return false;
-					}
+			/**
+			 * @brief the number of objects and arrays that are currently open
+			 */
+			size_t depth() const noexcept;
+	};
 
-					static bool is_string(const struct parsing_data& data)
-					{
-						if (data.hierarchy.empty())
-							return false;
-						else if (data.hierarchy.top().first == json_syntax::string_value)
-							return true;
-						else
-							return false;
-					}
+	/**
+	 * @class stream_parser
+	 * @brief parses a json document that arrives in chunks, e.g reads from a pipe or a socket. every chunk is parsed
+	 * as far as it can be and only the unfinished tail (a string, number or literal split between two chunks) is
+	 * kept until the next one, so the whole text is never held in memory at once
+	 * @detail @cpp
+	 * ljson::stream_parser parser;
+	 * while (size_t size = read(fd, buffer, sizeof(buffer)))
+	 *	parser.feed(std::string_view(buffer, size));
+	 * ljson::node node = parser.finish();
+	 * @ecpp
+	 */
+	class stream_parser {
+		private:
+			std::unique_ptr<struct stream_state> _state;
+			std::pmr::memory_resource*	     _resource;
 
-					static bool is_not_value(const struct parsing_data& data)
-					{
-						if (not data.json_objs.empty() && data.json_objs.top().type() == node_type::array)
-						{
-							return false;
-						}
-						else if (data.hierarchy.top().first != json_syntax::column &&
-							 data.hierarchy.top().first != json_syntax::string_value)
-							return true;
+		public:
+			/**
+			 * @param resource the memory resource the nodes are allocated from, it has to outlive them
+			 */
+			explicit stream_parser(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+			stream_parser(stream_parser&& other) noexcept;
+			stream_parser& operator=(stream_parser&& other) noexcept;
+			~stream_parser();
 
-						return false;
-					}
-			};
+			/**
+			 * @brief parses the next chunk of the document. after an error every call returns the same error
+			 * until finish() is called
+			 * @return ljson::monostate or ljson::error if the json is invalid
+			 */
+			expected<monostate, error> try_feed(std::string_view chunk) noexcept;
+			expected<monostate, error> try_feed(std::span<const std::byte> chunk) noexcept;
 
-			struct end_statement {
-					static bool next_char_is_newline(const struct parsing_data& data)
-					{
-						if (data.i == data.line.size() - 2 && data.line[data.i + 1] == '\n')
-							return true;
-						else
-							return false;
-					}
+			/**
+			 * @brief same as try_feed() but throws
+			 * @throw ljson::error if the json is invalid
+			 */
+			void feed(std::string_view chunk);
+			void feed(std::span<const std::byte> chunk);
+
+			/**
+			 * @brief parses what is left after the last chunk and hands over the document, the parser is ready
+			 * for a new document afterwards
+			 * @return ljson::node or ljson::error if the json is invalid or incomplete
+			 */
+			expected<ljson::node, error> try_finish() noexcept;
+
+			/**
+			 * @brief same as try_finish() but throws
+			 * @throw ljson::error if the json is invalid or incomplete
+			 */
+			ljson::node finish();
+	};
+
+	/**
+	 * @brief the order ljson::ndjson::try_for_each() hands the records to the callback in
+	 */
+	enum class ndjson_order {
+		ordered,
+		unordered,
+	};
+
+	/**
+	 * @class ndjson
+	 * @brief newline delimited json (json lines): one json object per line. blank lines are skipped. the records
+	 * can be read one at a time by iterating over an ndjson, or parsed in parallel with try_parse() and
+	 * try_for_each() which split the input into chunks of whole lines and hand them to worker threads
+	 * @detail @cpp
+	 * for (const ljson::expected<ljson::node, ljson::error>& record : ljson::ndjson(raw_json))
+	 *	if (record)
+	 *		std::println("{}", record.value().at("level").as_string_view());
+	 *
+	 * std::vector<ljson::node> records = ljson::ndjson::parse(raw_json); // uses every core
+	 * @ecpp
+	 */
+	class ndjson {
+		private:
+			std::string_view _raw_json;
+
+			/**
+			 * @brief parses one line, line is the 0-based line number of the record for error messages
+			 */
+			static expected<ljson::node, error> parse_record(std::string_view record, size_t line) noexcept;
+
+			/**
+			 * @brief parses every record of a chunk of whole lines, chunk is a view into raw_json
+			 */
+			static expected<monostate, error> parse_chunk(
+			    std::string_view raw_json, std::string_view chunk, std::vector<ljson::node>& records) noexcept;
+
+			/**
+			 * @brief splits the input into at most count chunks of whole lines, at least min_chunk_size bytes
+			 * each
+			 */
+			static std::vector<std::string_view> split(std::string_view raw_json, size_t count);
+
+		public:
+			static constexpr size_t min_chunk_size = 64 * 1024;
+
+			/**
+			 * @class iterator
+			 * @brief parses the next record when it's incremented. a record that fails to parse is handed
+			 * over as an ljson::error and the iteration continues with the next line
+			 */
+			class iterator {
+				private:
+					std::string_view	     _rest;
+					std::string_view	     _text;
+					size_t			     _line	= 0;
+					size_t			     _next_line = 0;
+					bool			     _end	= false;
+					expected<ljson::node, error> _record	= ljson::node(node_type::value);
+
+					void advance();
+
+				public:
+					using iterator_category = std::input_iterator_tag;
+					using value_type	= expected<ljson::node, error>;
+					using difference_type	= std::ptrdiff_t;
+
+					iterator() = default;
+					explicit iterator(std::string_view raw_json);
+
+					const expected<ljson::node, error>& operator*() const noexcept;
+					const expected<ljson::node, error>* operator->() const noexcept;
+					iterator&			    operator++();
+					void				    operator++(int);
+					bool				    operator==(std::default_sentinel_t) const noexcept;
+
+					/**
+					 * @brief the 1-based line number of the current record
+					 */
+					size_t line() const noexcept;
+
+					/**
+					 * @brief the line of the current record, a view into the input
+					 */
+					std::string_view text() const noexcept;
+			};
+
+			/**
+			 * @param raw_json the text, it has to outlive the ndjson and its iterators
+			 */
+			explicit ndjson(std::string_view raw_json) noexcept;
+
+			iterator		begin() const;
+			std::default_sentinel_t end() const noexcept;
+
+			/**
+			 * @brief parses every record, in parallel when the input is large enough
+			 * @param raw_json the text
+			 * @param threads the number of worker threads, 0 uses std::thread::hardware_concurrency()
+			 * @return the records in the order of the input or the ljson::error of the first invalid record
+			 */
+			static expected<std::vector<ljson::node>, error> try_parse(std::string_view raw_json, size_t threads = 0);
+
+			/**
+			 * @brief same as try_parse() but throws
+			 * @throw ljson::error if a record is invalid
+			 */
+			static std::vector<ljson::node> parse(std::string_view raw_json, size_t threads = 0);
+
+			/**
+			 * @brief parses every record in parallel and calls callback(ljson::node&) with each of them. the
+			 * callback is never called concurrently: with ndjson_order::ordered it's called from the calling
+			 * thread in the order of the input while the workers keep parsing ahead, with
+			 * ndjson_order::unordered it's called from the workers as soon as a chunk is done. an exception
+			 * thrown by the callback stops the workers and is rethrown
+			 * @param raw_json the text
+			 * @param callback called with every record
+			 * @param order the order the records are delivered in
+			 * @param threads the number of worker threads, 0 uses std::thread::hardware_concurrency()
+			 * @return ljson::monostate or the ljson::error of the first invalid record, the records before it
+			 * were delivered. with ndjson_order::unordered no chunk after the one holding the invalid record is
+			 * delivered once the failure is found, only chunks that were done before that
+			 */
+			template<typename callback_type>
+			static expected<monostate, error> try_for_each(std::string_view raw_json, callback_type&& callback,
+			    ndjson_order order = ndjson_order::ordered, size_t threads = 0);
+
+			/**
+			 * @brief same as try_for_each() but throws
+			 * @throw ljson::error if a record is invalid
+			 */
+			template<typename callback_type>
+			static void for_each(std::string_view raw_json, callback_type&& callback, ndjson_order order = ndjson_order::ordered,
+			    size_t threads = 0);
+	};
+
+	/**
+	 * @class document
+	 * @brief a parsed json document together with the arena its nodes, strings, arrays and objects are allocated
+	 * from. the arena hands out memory from a few large blocks and releases all of them at once when the last copy
+	 * of the document is destroyed, so nodes taken out of the document must not outlive it. the arena isn't
+	 * synchronized: a document (and its copies) must only be modified by one thread at a time
+	 * @detail @cpp
+	 * ljson::document document = ljson::document::parse(raw_json);
+	 * std::string	    name     = document.root().at("name").as_string();
+	 * @ecpp
+	 */
+	class document {
+		private:
+			ljson::node					     _root;
+			std::shared_ptr<std::pmr::monotonic_buffer_resource> _arena;
+
+			explicit document(size_t initial_size, std::pmr::memory_resource* upstream);
+
+		public:
+			/**
+			 * @brief creates a document with an empty object as root
+			 * @param upstream the memory resource the arena gets its blocks from
+			 */
+			explicit document(std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+			~document();
+
+			static ljson::document			parse(const std::filesystem::path& path);
+			static ljson::document			parse(const std::string& raw_json);
+			static ljson::document			parse(const char* raw_json);
+			static ljson::document			parse(std::string_view raw_json);
+			static expected<ljson::document, error> try_parse(const std::filesystem::path& path) noexcept;
+			static expected<ljson::document, error> try_parse(const std::string& raw_json) noexcept;
+			static expected<ljson::document, error> try_parse(const char* raw_json) noexcept;
+			static expected<ljson::document, error> try_parse(std::string_view raw_json) noexcept;
+
+			/**
+			 * @brief the root ljson::node of the document
+			 */
+			ljson::node&	   root() noexcept;
+			const ljson::node& root() const noexcept;
+
+			/**
+			 * @brief the arena of the document, to allocate new nodes next to the parsed ones
+			 * @detail @cpp
+			 * document.root().insert("list", ljson::node(ljson::node_type::array, document.resource()));
+			 * @ecpp
+			 */
+			std::pmr::memory_resource* resource() const noexcept;
+	};
+}
+
+namespace ljson {
+	/**
+	 * @brief the objects (false) and arrays (true) the parser is inside of. the first inline_depth levels are kept in
+	 * place so ordinary documents are parsed without allocating for them
+	 */
+	struct scope_stack {
+			static constexpr size_t inline_depth = 256;
+
+			std::array<uint64_t, inline_depth / 64> bits = {};
+			std::vector<bool>			deeper;
+			size_t					depth = 0;
+
+			void push_back(bool is_array)
+			{
+				if (depth < inline_depth)
+				{
+					const uint64_t mask = uint64_t(1) << (depth % 64);
+					bits[depth / 64]    = is_array ? bits[depth / 64] | mask : bits[depth / 64] & ~mask;
+				}
+				else
+					deeper.push_back(is_array);
+
+				depth++;
+			}
+
+			void pop_back()
+			{
+				assert(depth > 0);
+				if (--depth >= inline_depth)
+					deeper.pop_back();
+			}
+
+			bool back() const
+			{
+				assert(depth > 0);
+				const size_t top = depth - 1;
+				return top < inline_depth ? (bits[top / 64] >> (top % 64)) & 1 : deeper.back();
+			}
+
+			bool empty() const noexcept
+			{
+				return depth == 0;
+			}
+
+			size_t size() const noexcept
+			{
+				return depth;
+			}
+	};
+
+	struct parsing_data {
+			std::string_view	      raw_json;
+			size_t			      i = 0;
+			struct scope_stack	      scopes;
+			json_syntax		      state   = json_syntax::root;
+			const structural_index* index	= nullptr;
+			size_t			      index_i = 0;
+			std::vector<uint32_t>	      sizes;
+			size_t			      sizes_i = 0;
+			size_t			      value_begin = 0;
+			size_t			      lines_before = 0;
+			std::pmr::memory_resource*    resource = std::pmr::get_default_resource();
+	};
+
+	/**
+	 * @brief a range of elements of an array: begin is past the '[' or ',' in front of the first element and end is
+	 * at the ',' or ']' after the last one. index_i is the first structural position at or after begin
+	 */
+	struct array_chunk {
+			size_t begin   = 0;
+			size_t end     = 0;
+			size_t index_i = 0;
+	};
+
+	/**
+	 * @brief an array of the document cut into chunks, open_index and close_index are the structural positions of
+	 * its brackets and containers is the number of objects and arrays inside of it
+	 */
+	struct array_split {
+			size_t			 open_index  = 0;
+			size_t			 close_index = 0;
+			size_t			 containers  = 0;
+			std::vector<array_chunk> chunks;
+	};
+
+	struct parser_syntax {
+			static bool is_empty_char(const char ch)
+			{
+				return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r';
+			}
+
+			static bool is_end_of_token(const char ch)
+			{
+				return is_empty_char(ch) || ch == ',' || ch == '}' || ch == ']';
+			}
+
+			static void skip_empty(struct parsing_data& data)
+			{
+				if (data.index != nullptr)
+				{
+					const std::vector<uint32_t>& positions = data.index->positions();
+					while (data.index_i < positions.size() && positions[data.index_i] < data.i)
+						data.index_i++;
+					data.i = data.index_i < positions.size() ? positions[data.index_i] : data.raw_json.size();
+					return;
+				}
+
+				while (data.i < data.raw_json.size() && is_empty_char(data.raw_json[data.i]))
+				{
+					// indentation comes in runs of spaces or tabs, skip them 8 at a time
+					uint64_t word = 0;
+					if (data.i + sizeof(word) <= data.raw_json.size())
+						std::memcpy(&word, data.raw_json.data() + data.i, sizeof(word));
+
+					data.i += word == 0x2020202020202020 || word == 0x0909090909090909 ? sizeof(word) : 1;
+				}
+			}
+
+			/**
+			 * @brief estimates the number of elements of every object and array from the structural index, in the
+			 * order the parser opens them, so their storage can be reserved up front. the estimate counts the
+			 * commas at the container's depth, a trailing comma makes it one too big
+			 */
+			static void estimate_sizes(struct parsing_data& data)
+			{
+				const std::vector<uint32_t>& positions = data.index->positions();
+				std::vector<uint32_t>	     open;
 
-					static bool end_of_line_after_bracket(const struct parsing_data& data)
+				for (size_t i = 0; i < positions.size(); i++)
+				{
+					const char ch = data.raw_json[positions[i]];
+					if (ch == '{' || ch == '[')
 					{
-						if (data.hierarchy.empty())
-							return false;
-						else if (data.hierarchy.top().first == json_syntax::column &&
-							 data.i == data.line.size() - 1)
-							return true;
-						return false;
+						const char closing = ch == '{' ? '}' : ']';
+						const bool empty   = i + 1 < positions.size() && data.raw_json[positions[i + 1]] == closing;
+
+						open.push_back(static_cast<uint32_t>(data.sizes.size()));
+						data.sizes.push_back(empty ? 0 : 1);
 					}
+					else if (ch == ',' && not open.empty())
+						data.sizes[open.back()]++;
+					else if ((ch == '}' || ch == ']') && not open.empty())
+						open.pop_back();
+				}
+			}
+
+			/**
+			 * @brief reserves the estimated size for the container the parser just opened
+			 */
+			static void reserve_next(struct parsing_data& data, ljson::node& container)
+			{
+				if (data.sizes_i < data.sizes.size())
+					container.reserve(data.sizes[data.sizes_i++]);
+			}
+
+			static size_t line_number(const struct parsing_data& data)
+			{
+				size_t end = std::min(data.i, data.raw_json.size());
+				return 1 + data.lines_before + std::count(data.raw_json.begin(), data.raw_json.begin() + end, '\n');
+			}
+
+			static error syntax_error(const struct parsing_data& data, const std::string& expected_x)
+			{
+				if (data.i >= data.raw_json.size())
+					return error(error_type::parsing_error, "syntax error: expected {} but reached the end of input at line: {}",
+					    expected_x, line_number(data));
 
-					static expected<bool, error> flush_value(struct parsing_data& data)
+				return error(error_type::parsing_error, "syntax error: expected {} but found '{}' at line: {}", expected_x,
+				    data.raw_json[data.i], line_number(data));
+			}
+
+			struct string {
+					/**
+					 * @brief scans a json string starting at the opening quote. the content is kept as written in
+					 * the input (escape sequences are validated but not decoded)
+					 * @return the content between the quotes, the cursor is left after the closing quote
+					 */
+					static expected<std::string_view, error> handle_string(struct parsing_data& data)
 					{
-						data.hierarchy.push({json_syntax::flush_value, data.line_number});
-						return handle_end_statement(data);
+						if (data.index != nullptr)
+							return handle_indexed_string(data);
+
+						// jump from quote to quote with memchr, the backslashes in between are checked the same
+						// way and a quote right after one of them doesn't end the string
+						const char* raw	  = data.raw_json.data();
+						const size_t size  = data.raw_json.size();
+						size_t	     begin = ++data.i;
+						while (const void* quote = std::memchr(raw + data.i, '"', size - data.i))
+						{
+							size_t end	   = static_cast<const char*>(quote) - raw;
+							bool   escaped = false;
+							while (const void* backslash = std::memchr(raw + data.i, '\\', end - data.i))
+							{
+								data.i = static_cast<const char*>(backslash) - raw + 1;
+								if (not is_escape_char(raw[data.i]))
+									return unexpected(escape_error(data));
+								else if (data.i++ == end)
+								{
+									escaped = true;
+									break;
+								}
+							}
+
+							if (not escaped)
+							{
+								data.i = end + 1;
+								return data.raw_json.substr(begin, end - begin);
+							}
+						}
+
+						data.i = begin - 1;
+						return unexpected(syntax_error(data, "a closing quote for the string"));
 					}
 
-					static bool pop_flush_element(const struct parsing_data& data)
+					/**
+					 * @brief same as handle_string() but the closing quote is the next indexed position, only
+					 * the backslashes in between are checked
+					 */
+					static expected<std::string_view, error> handle_indexed_string(struct parsing_data& data)
 					{
-						if (not data.hierarchy.empty() && data.hierarchy.top().first == json_syntax::flush_value)
+						const std::vector<uint32_t>& positions = data.index->positions();
+						assert(data.index_i < positions.size() && positions[data.index_i] == data.i);
+
+						size_t begin = data.i + 1;
+						size_t end   = data.index_i + 1 < positions.size() ? positions[data.index_i + 1] : data.raw_json.size();
+
+						for (size_t i = begin; i < end; i++)
 						{
-							return true;
+							const void* backslash = std::memchr(data.raw_json.data() + i, '\\', end - i);
+							if (backslash == nullptr)
+								break;
+
+							i = static_cast<const char*>(backslash) - data.raw_json.data() + 1;
+							if (i >= data.raw_json.size())
+								break;
+							if (not is_escape_char(data.raw_json[i]))
+							{
+								data.i = i;
+								return unexpected(escape_error(data));
+							}
 						}
 
-						return false;
+						if (end == data.raw_json.size())
+							return unexpected(syntax_error(data, "a closing quote for the string"));
+
+						data.index_i += 2;
+						data.i = end + 1;
+						return data.raw_json.substr(begin, end - begin);
 					}
 
-					static bool empty_space_in_number(struct parsing_data& data)
+					static error escape_error(const struct parsing_data& data)
 					{
-						bool found_empty = false;
+						return error(error_type::parsing_error,
+						    "escape sequence is incorrect. expected [\", \\, t, b, f, n, r, u, /] found: {} at line: {}",
+						    data.raw_json[data.i], line_number(data));
+					}
 
-						auto empty_char = [](char ch)
+					static bool is_escape_char(const char ch)
+					{
+						switch (ch)
 						{
-							if (ch == ' ' || ch == '\t')
+							case '"':
+							case '\\':
+							case 't':
+							case 'b':
+							case 'f':
+							case 'n':
+							case 'r':
+							case 'u':
+							case '/':
 								return true;
-							return false;
-						};
-
-						for (size_t& i = data.i; i < data.line.size(); i++)
-						{
-							if (empty_char(data.line[i]))
-								found_empty = true;
-							else if (data.line[i] == ',' || data.line[i] == '\n')
+							default:
 								return false;
-							else if (found_empty && not empty_char(data.line[i]))
-								return true;
 						}
-
-						return false;
 					}
+			};
 
-					static expected<bool, error> handle_end_statement(struct parsing_data& data)
+			struct literal {
+					/**
+					 * @brief scans a non-string json value (number, boolean or null) and reports it to the
+					 * handler without building a ljson::value
+					 * @return what the handler returned or ljson::error of type parsing_error_wrong_type if the
+					 * value is unknown
+					 */
+					template<typename handler_type>
+					static expected<bool, error> handle_literal(struct parsing_data& data, handler_type& handler)
 					{
-						if (not is_end_statement(data))
+						size_t begin = data.i;
+						while (data.i < data.raw_json.size() && not is_end_of_token(data.raw_json[data.i]))
+							data.i++;
+
+						std::string_view token = data.raw_json.substr(begin, data.i - begin);
+						if (token == "null")
+							return handler.on_null();
+						else if (token == "true")
+							return handler.on_boolean(true);
+						else if (token == "false")
+							return handler.on_boolean(false);
+
+						auto number = handle_number(token);
+						if (not number)
 						{
-							return false;
+							data.i = begin;
+							if (number.error() == error_type::number_out_of_range)
+								return unexpected(error(error_type::number_out_of_range, "number out of range: '{}' at line: {}",
+								    token, line_number(data)));
+
+							return unexpected(
+							    error(error_type::parsing_error_wrong_type, "unknown type: '{}' at line: {}", token, line_number(data)));
 						}
-						else if (not there_is_a_value(data))
-							return false;
+						else if (const int64_t* integer = std::get_if<int64_t>(&number.value()))
+							return handler.on_integer(*integer);
+
+						return handler.on_double(std::get<double>(number.value()));
+					}
 
-						if (next_char_is_newline(data))
-							data.line.pop_back();
+					/**
+					 * @brief classifies and converts a number in one pass over the token. integers are
+					 * accumulated while scanning, a fraction or an exponent hands the token to std::from_chars.
+					 * a fraction without leading or trailing digits is allowed ('.5', '1.')
+					 * @return the int64_t or double, error_type::parsing_error_wrong_type if the token isn't a
+					 * number or error_type::number_out_of_range if it doesn't fit in int64_t/double
+					 */
+					static expected<std::variant<int64_t, double>, error_type> handle_number(std::string_view token)
+					{
+						size_t	 i	   = 0;
+						size_t	 digits	   = 0;
+						uint64_t magnitude = 0;
+						bool	 overflow  = false;
+						bool	 negative  = false;
 
-						if (pop_flush_element(data))
-							data.hierarchy.pop();
+						auto is_digit = [&]() { return i < token.size() && token[i] >= '0' && token[i] <= '9'; };
 
-						if (data.raw_value.first == "null")
-						{
-							data.raw_value.second = value_type::null;
-						}
-						else if (data.raw_value.first == "true" || data.raw_value.first == "false")
+						if (i < token.size() && token[i] == '-')
 						{
-							data.raw_value.second = value_type::boolean;
+							negative = true;
+							i++;
 						}
-						else if (is_num_decimal(data.raw_value.first))
+
+						for (; is_digit(); i++, digits++)
 						{
-							if (data.raw_value.first.find('.') != data.raw_value.first.npos)
-							{
-								data.raw_value.second = value_type::double_t;
-							}
+							uint64_t digit = static_cast<uint64_t>(token[i] - '0');
+							if (magnitude > (UINT64_MAX - digit) / 10)
+								overflow = true;
 							else
-								data.raw_value.second = value_type::integer;
-							if (empty_space_in_number(data))
-							{
-								return unexpected(error(error_type::parsing_error_wrong_type,
-								    std::format("type error: '{}', in line: '{}'", data.raw_value.first,
-									data.line)));
-							}
+								magnitude = magnitude * 10 + digit;
 						}
-						else if (data.raw_value.second == ljson::value_type::none && data.raw_value.first.empty())
+
+						if (i == token.size() && digits != 0)
 						{
-							return true;
+							uint64_t limit = negative ? uint64_t(INT64_MAX) + 1 : uint64_t(INT64_MAX);
+							if (overflow || magnitude > limit)
+								return unexpected(error_type::number_out_of_range);
+
+							return std::variant<int64_t, double>(
+							    negative ? static_cast<int64_t>(0 - magnitude) : static_cast<int64_t>(magnitude));
 						}
-						else if (data.raw_value.second != ljson::value_type::string)
+
+						if (i < token.size() && token[i] == '.')
 						{
-							data.raw_value.second = value_type::unknown;
-							return unexpected(error(error_type::parsing_error_wrong_type,
-							    std::format(
-								"unknown type: '{}', in line: '{}'", data.raw_value.first, data.line)));
+							for (i++; is_digit(); i++)
+								digits++;
 						}
 
-						auto ok = data.value.set_value_type(data.raw_value.first, data.raw_value.second);
-						if (not ok)
+						if (digits == 0)
+							return unexpected(error_type::parsing_error_wrong_type);
+
+						if (i < token.size() && (token[i] == 'e' || token[i] == 'E'))
 						{
-							return ok.error();
+							i++;
+							if (i < token.size() && (token[i] == '+' || token[i] == '-'))
+								i++;
+							if (not is_digit())
+								return unexpected(error_type::parsing_error_wrong_type);
+							while (is_digit())
+								i++;
 						}
 
-						data.raw_value.first.clear();
-						data.raw_value.second = value_type::none;
+						if (i != token.size())
+							return unexpected(error_type::parsing_error_wrong_type);
+
+						double number  = 0;
+						auto [end, ec] = std::from_chars(token.data(), token.data() + token.size(), number);
+						if (ec == std::errc::result_out_of_range)
+							return unexpected(error_type::number_out_of_range);
+						else if (ec != std::errc() || end != token.data() + token.size())
+							return unexpected(error_type::parsing_error_wrong_type);
+
+						return std::variant<int64_t, double>(number);
+					}
+			};
+
+			static error stopped_error(const struct parsing_data& data)
+			{
+				return error(error_type::parsing_stopped, "parsing stopped by the handler at line: {}", line_number(data));
+			}
+
+			struct value {
+					/**
+					 * @brief opens an object or array, the cursor is already past the bracket
+					 */
+					template<typename handler_type>
+					static expected<monostate, error> open_container(struct parsing_data& data, handler_type& handler, bool is_array)
+					{
+						data.scopes.push_back(is_array);
+						data.state = is_array ? json_syntax::value_or_end : json_syntax::key_or_end;
+
+						if (not(is_array ? handler.on_array_start() : handler.on_object_start()))
+							return unexpected(stopped_error(data));
+
+						return monostate();
+					}
+
+					/**
+					 * @brief handles a value inside the current object/array and reports it to the handler.
+					 * objects and arrays are opened, everything else is reported right away
+					 */
+					template<typename handler_type>
+					static expected<monostate, error> handle_value(struct parsing_data& data, handler_type& handler)
+					{
+						const char ch = data.raw_json[data.i];
+						data.value_begin = data.i;
 
-						if (data.keys.top().second == key_type::simple_key)
+						if (ch == '{' || ch == '[')
 						{
-							auto ok = data.json_objs.top().insert(data.keys.top().first, data.value);
-							if (not ok)
-							{
-								return unexpected(error(error_type::parsing_error,
-								    std::format("{}", ljson::log("internal parsing error: [adding "
-												 "value to simple_key]"))));
-							}
+							data.i++;
+							return open_container(data, handler, ch == '[');
 						}
-						else if (object::is_object(data))
+
+						bool keep_going = true;
+						if (ch == '"')
 						{
-							auto ok = fill_object_data(data);
+							auto ok = string::handle_string(data);
 							if (not ok)
 								return unexpected(ok.error());
+							keep_going = handler.on_string(ok.value());
 						}
-						else if (array::is_array(data))
+						else
 						{
-							auto ok = fill_array_data(data);
+							auto ok = literal::handle_literal(data, handler);
 							if (not ok)
 								return unexpected(ok.error());
-							return true;
+							keep_going = ok.value();
 						}
 
-						data.keys.top().first.clear();
-						data.keys.top().second = key_type::none;
-						data.hierarchy.pop();
-						return true;
+						if (not keep_going)
+							return unexpected(stopped_error(data));
+
+						data.state = json_syntax::end_statement;
+						return monostate();
 					}
+			};
 
-					static bool is_end_statement(const struct parsing_data& data)
+			struct closing_bracket {
+					template<typename handler_type>
+					static expected<monostate, error> handle_closing_bracket(struct parsing_data& data, handler_type& handler)
 					{
-						if (data.line[data.i] == ',' && not value::is_string(data))
-							return true;
-						else if (data.i == data.line.size() - 1 && not object::brackets_at_end_of_line(data) &&
-							 not array::brackets_at_end_of_line(data) && not value::is_string(data))
-							return true;
-						else if (not data.hierarchy.empty() &&
-							 data.hierarchy.top().first == json_syntax::flush_value)
-						{
-							return true;
-						}
-						else if (data.line[data.i] == '}' && not data.raw_value.first.empty())
-						{
-							return true;
-						}
-						else
-							return false;
+						const bool is_array = data.scopes.back();
+
+						data.i++;
+						data.scopes.pop_back();
+						data.state = data.scopes.empty() ? json_syntax::done : json_syntax::end_statement;
+
+						if (not(is_array ? handler.on_array_end() : handler.on_object_end()))
+							return unexpected(stopped_error(data));
+
+						return monostate();
 					}
+			};
 
-					static bool there_is_a_value(const struct parsing_data& data)
+			/**
+			 * @brief the check-only pass of parser::validate(). it accepts the same documents as parser::next_event()
+			 * but only moves a cursor: string bodies are skipped a word at a time and plain numbers are checked
+			 * without being converted. the position in the loop stands for the json_syntax state, so no state is
+			 * stored per token. it only answers valid or not, the event parser describes the problem
+			 */
+			struct validator {
+					static constexpr uint64_t ones = 0x0101010101010101;
+					static constexpr uint64_t highs = 0x8080808080808080;
+
+					/**
+					 * @brief like parser_syntax::skip_empty() but a run of spaces ends at its first other byte
+					 * instead of being skipped 8 at a time only while it lasts. most tokens aren't preceded by
+					 * whitespace, that check is kept small enough to be inlined
+					 */
+					static void skip_empty(std::string_view raw_json, size_t& cursor)
 					{
-						if (data.hierarchy.empty())
-							return false;
-						else if (data.hierarchy.top().first == json_syntax::column)
-							return true;
-						else if (data.hierarchy.top().first == json_syntax::flush_value)
-							return true;
-						else if (array::is_array(data))
-							return true;
+						if (cursor >= raw_json.size() || static_cast<unsigned char>(raw_json[cursor]) > ' ')
+							return;
 
-						return false;
+						skip_empty_run(raw_json, cursor);
 					}
 
-					static expected<monostate, error> fill_object_data(struct parsing_data& data)
+					static void skip_empty_run(std::string_view raw_json, size_t& cursor)
 					{
-						if (data.keys.top().second == key_type::simple_key)
+						size_t i = cursor;
+						while (i < raw_json.size() && is_empty_char(raw_json[i]))
 						{
-							auto ok = data.json_objs.top().insert(data.keys.top().first, data.value);
-							if (not ok)
+							if (std::endian::native == std::endian::little && raw_json[i] == ' ' &&
+							    i + sizeof(uint64_t) <= raw_json.size())
 							{
-								return unexpected(error(error_type::parsing_error,
-								    "internal parsing error\n[adding value to object]"));
+								uint64_t word = 0;
+								std::memcpy(&word, raw_json.data() + i, sizeof(word));
+
+								const uint64_t others = word ^ (ones * ' ');
+								i += others == 0 ? sizeof(word) : static_cast<size_t>(std::countr_zero(others)) / 8;
 							}
+							else
+								i++;
 						}
+						cursor = i;
+					}
+
+					/**
+					 * @brief moves the cursor to the next quote or backslash, 8 bytes at a time
+					 */
+					static size_t find_quote_or_backslash(std::string_view raw_json, size_t i)
+					{
+						if constexpr (std::endian::native == std::endian::little)
+						{
+							for (; i + sizeof(uint64_t) <= raw_json.size(); i += sizeof(uint64_t))
+							{
+								uint64_t word = 0;
+								std::memcpy(&word, raw_json.data() + i, sizeof(word));
+
+								// a byte is zero after the xor where it matched, the lowest flagged byte is exact
+								const uint64_t quote	 = word ^ (ones * '"');
+								const uint64_t backslash = word ^ (ones * '\\');
+								const uint64_t found	 = (((quote - ones) & ~quote) | ((backslash - ones) & ~backslash)) & highs;
+								if (found != 0)
+									return i + static_cast<size_t>(std::countr_zero(found)) / 8;
+							}
+						}
+
+						while (i < raw_json.size() && raw_json[i] != '"' && raw_json[i] != '\\')
+							i++;
+
+						return i;
+					}
+
+					/**
+					 * @brief the cursor is past the opening quote and is left past the closing one. a string
+					 * without escapes that ends in the first word is handled without a call
+					 */
+					static bool skip_string(std::string_view raw_json, size_t& cursor)
+					{
+						if constexpr (std::endian::native == std::endian::little)
+						{
+							if (raw_json.size() - cursor >= sizeof(uint64_t))
+							{
+								uint64_t word = 0;
+								std::memcpy(&word, raw_json.data() + cursor, sizeof(word));
+
+								const uint64_t quote	 = word ^ (ones * '"');
+								const uint64_t backslash = word ^ (ones * '\\');
+								const uint64_t found	 = (((quote - ones) & ~quote) | ((backslash - ones) & ~backslash)) & highs;
+								const size_t   end	 = cursor + static_cast<size_t>(std::countr_zero(found)) / 8;
+								if (found != 0 && raw_json[end] == '"')
+								{
+									cursor = end + 1;
+									return true;
+								}
+							}
+						}
+
+						return skip_string_run(raw_json, cursor);
+					}
+
+					static bool skip_string_run(std::string_view raw_json, size_t& cursor)
+					{
+						size_t i = cursor;
+						while (true)
+						{
+							i = find_quote_or_backslash(raw_json, i);
+							if (i >= raw_json.size())
+								return false;
+							else if (raw_json[i++] == '"')
+							{
+								cursor = i;
+								return true;
+							}
+							else if (i >= raw_json.size() || not string::is_escape_char(raw_json[i++]))
+								return false;
+						}
+					}
+
+					/**
+					 * @brief the same tokens literal::handle_literal() accepts. the keywords, integers of up to 18
+					 * digits and fractions without an exponent that are short enough to fit a double are checked in
+					 * place, any other token goes through literal::handle_number()
+					 */
+					static bool skip_literal(std::string_view raw_json, size_t& cursor)
+					{
+						const size_t begin = cursor;
+						size_t	     i	   = cursor;
+						auto	     ends  = [&](size_t end) { return end == raw_json.size() || is_end_of_token(raw_json[end]); };
+
+						if (raw_json[i] == '-')
+							i++;
+
+						const size_t integer = i;
+						while (i < raw_json.size() && raw_json[i] >= '0' && raw_json[i] <= '9')
+							i++;
+
+						if (i == integer)
+						{
+							const char	 first	 = raw_json[i];
+							std::string_view keyword = first == 'n' ? "null" : first == 't' ? "true" : "false";
+							if (i == begin && raw_json.size() - i >= keyword.size() &&
+							    std::memcmp(raw_json.data() + i, keyword.data(), keyword.size()) == 0 && ends(i + keyword.size()))
+							{
+								cursor = i + keyword.size();
+								return true;
+							}
+						}
+						else if (i - integer <= 18 && ends(i))
+						{
+							cursor = i;
+							return true;
+						}
+						else if (i < raw_json.size() && raw_json[i] == '.')
+						{
+							for (i++; i < raw_json.size() && raw_json[i] >= '0' && raw_json[i] <= '9';)
+								i++;
+
+							if (i - begin <= 300 && ends(i))
+							{
+								cursor = i;
+								return true;
+							}
+						}
+
+						while (not ends(i))
+							i++;
+
+						cursor = i;
+						return literal::handle_number(raw_json.substr(begin, i - begin)).has_value();
+					}
+
+					static bool is_valid(std::string_view raw_json)
+					{
+						struct scope_stack scopes;
+						size_t		   i = 0;
+
+						skip_empty(raw_json, i);
+						if (i >= raw_json.size())
+							return true;
+						else if (raw_json[i] != '{')
+							return false;
+
+						i++;
+						scopes.push_back(false);
+						bool in_array = false;
+
+						while (true)
+						{
+							// past '{', '[' or ',': a key or a value, or the container closes (key_or_end, value_or_end)
+							skip_empty(raw_json, i);
+							if (i >= raw_json.size())
+								return false;
+							else if (raw_json[i] != (in_array ? ']' : '}'))
+							{
+								if (not in_array)
+								{
+									if (raw_json[i] == ',')
+									{
+										i++;
+										continue;
+									}
+									else if (raw_json[i] != '"' || not skip_string(raw_json, ++i))
+										return false;
+
+									skip_empty(raw_json, i);
+									if (i >= raw_json.size() || raw_json[i] != ':')
+										return false;
+
+									skip_empty(raw_json, ++i);
+									if (i >= raw_json.size())
+										return false;
+								}
+
+								const char ch = raw_json[i];
+								if (ch == '{' || ch == '[')
+								{
+									i++;
+									in_array = ch == '[';
+									scopes.push_back(in_array);
+									continue;
+								}
+								else if (is_end_of_token(ch) || not(ch == '"' ? skip_string(raw_json, ++i) : skip_literal(raw_json, i)))
+									return false;
+							}
+
+							// past a value or on a closing bracket (end_statement), every container closed here is
+							// followed by the same check
+							while (true)
+							{
+								skip_empty(raw_json, i);
+								if (i >= raw_json.size())
+									return false;
+								else if (raw_json[i] == ',')
+								{
+									i++;
+									break;
+								}
+								else if (raw_json[i] != (in_array ? ']' : '}'))
+									return false;
+
+								i++;
+								scopes.pop_back();
+								if (scopes.empty())
+								{
+									// done, only whitespace may follow the root object
+									skip_empty(raw_json, i);
+									return i >= raw_json.size();
+								}
+								in_array = scopes.back();
+							}
+						}
+					}
+			};
+
+			/**
+			 * @brief the handler that builds the ljson::node tree of parser::try_parse(). the root object is
+			 * created by the caller, every other object and array is reserved with the estimated size
+			 */
+			struct dom_builder {
+					struct parsing_data&	data;
+					ljson::node&		root;
+					std::stack<ljson::node> json_objs;
+					std::string		key;
+
+					bool open(node_type type)
+					{
+						if (json_objs.empty())
+						{
+							reserve_next(data, root);
+							json_objs.push(root);
+							return true;
+						}
+
+						ljson::node child(type, data.resource);
+						reserve_next(data, child);
+						this->add(ljson::node(child));
+						json_objs.push(std::move(child));
+						return true;
+					}
+
+					bool add(ljson::node&& child)
+					{
+						ljson::node& parent = json_objs.top();
+						if (parent.is_array())
+							parent._array->data.push_back(std::move(child));
+						else
+							parent._object->data.insert(key, std::move(child));
+
+						return true;
+					}
+
+					bool add_scalar(node::tag tag, int64_t integer = 0, double number = 0, bool boolean = false)
+					{
+						ljson::node child(node_type::value);
+						child._tag = tag;
+						if (tag == node::tag::double_t)
+							child._double = number;
+						else if (tag == node::tag::boolean)
+							child._boolean = boolean;
+						else
+							child._integer = integer;
+
+						return this->add(std::move(child));
+					}
+
+					bool on_object_start()
+					{
+						return this->open(node_type::object);
+					}
+
+					bool on_array_start()
+					{
+						return this->open(node_type::array);
+					}
+
+					bool on_object_end()
+					{
+						json_objs.pop();
+						return true;
+					}
+
+					bool on_array_end()
+					{
+						json_objs.pop();
+						return true;
+					}
+
+					bool on_key(std::string_view string)
+					{
+						key = string;
+						return true;
+					}
+
+					bool on_string(std::string_view string)
+					{
+						ljson::node child(node_type::value);
+						child.set_string(string, data.resource);
+						return this->add(std::move(child));
+					}
+
+					bool on_integer(int64_t number)
+					{
+						return this->add_scalar(node::tag::integer, number);
+					}
+
+					bool on_double(double number)
+					{
+						return this->add_scalar(node::tag::double_t, 0, number);
+					}
+
+					bool on_boolean(bool boolean)
+					{
+						return this->add_scalar(node::tag::boolean, 0, 0, boolean);
+					}
+
+					bool on_null()
+					{
+						return this->add_scalar(node::tag::null);
+					}
+			};
+
+			/**
+			 * @brief the handler of ljson::reader, it keeps the last event as a ljson::token
+			 */
+			struct token_recorder {
+					struct parsing_data& data;
+					ljson::token&	     token;
+
+					bool record(token_type type, std::string_view text)
+					{
+						token = ljson::token{type, text};
+						return true;
+					}
+
+					bool record_bracket(token_type type)
+					{
+						return this->record(type, data.raw_json.substr(data.i - 1, 1));
+					}
+
+					bool record_literal(token_type type)
+					{
+						return this->record(type, data.raw_json.substr(data.value_begin, data.i - data.value_begin));
+					}
+
+					bool on_object_start()
+					{
+						return this->record_bracket(token_type::start_object);
+					}
+
+					bool on_object_end()
+					{
+						return this->record_bracket(token_type::end_object);
+					}
+
+					bool on_array_start()
+					{
+						return this->record_bracket(token_type::start_array);
+					}
+
+					bool on_array_end()
+					{
+						return this->record_bracket(token_type::end_array);
+					}
+
+					bool on_key(std::string_view key)
+					{
+						return this->record(token_type::key, key);
+					}
+
+					bool on_string(std::string_view string)
+					{
+						return this->record(token_type::string, string);
+					}
+
+					bool on_integer(int64_t)
+					{
+						return this->record_literal(token_type::number);
+					}
+
+					bool on_double(double)
+					{
+						return this->record_literal(token_type::number);
+					}
+
+					bool on_boolean(bool)
+					{
+						return this->record_literal(token_type::boolean);
+					}
+
+					bool on_null()
+					{
+						return this->record_literal(token_type::null);
+					}
+			};
+
+			/**
+			 * @brief finds the largest array of the document in the structural index and cuts it into about
+			 * count chunks of whole elements
+			 * @return the array, without chunks if it's smaller than min_size
+			 */
+			static struct array_split split_largest_array(const struct parsing_data& data, size_t count, size_t min_size)
+			{
+				const std::vector<uint32_t>&	    positions = data.index->positions();
+				struct array_split		    split;
+				std::vector<std::pair<size_t, size_t>> open; // the bracket and the number of containers before it
+				size_t				    opened  = 0;
+				size_t				    largest = 0;
+
+				for (size_t i = 0; i < positions.size(); i++)
+				{
+					const char ch = data.raw_json[positions[i]];
+					if (ch == '{' || ch == '[')
+						open.emplace_back(i, opened++);
+					else if ((ch == '}' || ch == ']') && not open.empty())
+					{
+						auto [begin, before] = open.back();
+						open.pop_back();
+						if (ch == ']' && data.raw_json[positions[begin]] == '[' && positions[i] - positions[begin] > largest)
+						{
+							largest		  = positions[i] - positions[begin];
+							split.open_index  = begin;
+							split.close_index = i;
+							split.containers  = opened - before - 1;
+						}
+					}
+				}
+
+				if (largest < min_size)
+					return split;
+
+				// cut at the first comma between two elements after every step bytes, a mismatched bracket
+				// stops the cutting and is reported by the worker that parses it. a trailing comma is never
+				// cut at, it would leave an empty last chunk
+				const size_t step  = largest / std::max<size_t>(count, 1);
+				size_t	     depth = 0;
+				array_chunk  chunk{positions[split.open_index] + 1, 0, split.open_index + 1};
+
+				for (size_t i = split.open_index + 1; i < split.close_index; i++)
+				{
+					const char ch = data.raw_json[positions[i]];
+					if (ch == '{' || ch == '[')
+						depth++;
+					else if (ch == '}' || ch == ']')
+						depth--;
+					else if (ch == ',' && depth == 0 && positions[i] - chunk.begin >= step && i + 1 < split.close_index)
+					{
+						chunk.end = positions[i];
+						split.chunks.push_back(chunk);
+						chunk = array_chunk{positions[i] + 1, 0, i + 1};
+					}
+				}
+
+				chunk.end = positions[split.close_index];
+				split.chunks.push_back(chunk);
+				return split;
+			}
+
+			/**
+			 * @brief builds the document like dom_builder except for the array of split: when it's opened the
+			 * cursor jumps to its closing bracket and the empty array node is kept in target, its elements are
+			 * parsed by the workers of parser::try_parse_parallel()
+			 */
+			struct skipping_builder : dom_builder {
+					const struct array_split& split;
+					ljson::node		  target = ljson::node(node_type::value);
+
+					bool on_array_start()
+					{
+						const std::vector<uint32_t>& positions = data.index->positions();
+						if (data.i - 1 != positions[split.open_index])
+							return dom_builder::on_array_start();
+
+						bool ok = dom_builder::on_array_start();
+						target	= json_objs.top();
+
+						data.i	     = positions[split.close_index];
+						data.index_i = split.close_index;
+						data.sizes_i += split.containers;
+						data.state = json_syntax::end_statement;
+						return ok;
+					}
+			};
+	};
+
+	/**
+	 * @brief the state ljson::stream_parser keeps between chunks. pending holds the input that wasn't parsed yet,
+	 * it always starts outside of a string so it can be indexed on its own
+	 */
+	struct stream_state {
+			struct parsing_data	  data;
+			ljson::node		  root;
+			parser_syntax::dom_builder builder{data, root, {}, {}};
+			std::string		  pending;
+			structural_index	  index;
+			error			  failure = error(error_type::none, "");
+
+			// a string left open at the end of pending and how far it was scanned for its closing quote
+			bool   in_string = false;
+			bool   escaped	 = false;
+			size_t scanned	 = 0;
+
+			explicit stream_state(std::pmr::memory_resource* resource) : root(node_type::object, resource)
+			{
+				data.resource = resource;
+			}
+
+			/**
+			 * @brief scans the open string from scanned to the end of pending, a word at a time
+			 * @return true if its closing quote was found
+			 */
+			bool close_string()
+			{
+				std::string_view text = pending;
+				while (scanned < text.size())
+				{
+					if (escaped)
+					{
+						escaped = false;
+						scanned++;
+						continue;
+					}
+
+					scanned = parser_syntax::validator::find_quote_or_backslash(text, scanned);
+					if (scanned >= text.size())
+						break;
+
+					escaped = text[scanned] == '\\';
+					if (text[scanned++] == '"')
+					{
+						in_string = false;
+						return true;
+					}
+				}
+
+				return false;
+			}
+	};
+
+	node::node() : _object(make_storage<ljson::object>(std::pmr::get_default_resource())), _tag(tag::object)
+	{
+	}
+
+	node::node(const json_node& n)
+	{
+		if (auto value = std::get_if<std::shared_ptr<class value>>(&n); value && *value)
+		{
+			this->set_value(**value);
+		}
+		else if (auto array = std::get_if<std::shared_ptr<ljson::array>>(&n); array && *array)
+		{
+			_array = make_storage<ljson::array>(std::pmr::get_default_resource(), **array);
+			_tag   = tag::array;
+		}
+		else if (auto object = std::get_if<std::shared_ptr<ljson::object>>(&n); object && *object)
+		{
+			_object = make_storage<ljson::object>(std::pmr::get_default_resource(), **object);
+			_tag	= tag::object;
+		}
+	}
+
+	node::node(enum node_type type)
+	{
+		switch (type)
+		{
+			case node_type::value:
+				break;
+			case node_type::array:
+				this->reset(tag::array);
+				break;
+			case ljson::node_type::object:
+				this->reset(tag::object);
+				break;
+		}
+	}
+
+	node::node(enum node_type type, std::pmr::memory_resource* resource)
+	{
+		switch (type)
+		{
+			case node_type::value:
+				break;
+			case node_type::array:
+				this->reset(tag::array, resource);
+				break;
+			case ljson::node_type::object:
+				this->reset(tag::object, resource);
+				break;
+		}
+	}
+
+	template<typename T, typename... args_t>
+	node::shared_storage<T>* node::make_storage(std::pmr::memory_resource* resource, args_t&&... args)
+	{
+		void* memory = resource->allocate(sizeof(shared_storage<T>), alignof(shared_storage<T>));
+		try
+		{
+			return ::new (memory) shared_storage<T>(resource, std::forward<args_t>(args)...);
+		}
+		catch (...)
+		{
+			resource->deallocate(memory, sizeof(shared_storage<T>), alignof(shared_storage<T>));
+			throw;
+		}
+	}
+
+	template<typename T>
+	void node::release_storage(shared_storage<T>* storage) noexcept
+	{
+		if (storage->references.fetch_sub(1, std::memory_order_acq_rel) != 1)
+			return;
+
+		std::pmr::memory_resource* resource = storage->resource;
+		storage->~shared_storage<T>();
+		resource->deallocate(storage, sizeof(shared_storage<T>), alignof(shared_storage<T>));
+	}
+
+	node::node(const node& other) noexcept
+	{
+		this->copy_from(other);
+	}
+
+	node::node(node&& other) noexcept
+	{
+		this->move_from(other);
+	}
+
+	node& node::operator=(const node& other) noexcept
+	{
+		if (this != &other)
+		{
+			this->release();
+			this->copy_from(other);
+		}
+
+		return *this;
+	}
+
+	node& node::operator=(node&& other) noexcept
+	{
+		if (this != &other)
+		{
+			this->release();
+			this->move_from(other);
+		}
+
+		return *this;
+	}
+
+	node::~node()
+	{
+		this->release();
+	}
+
+	void node::copy_from(const node& other) noexcept
+	{
+		std::memcpy(&_integer, &other._integer, sizeof(_integer));
+		_tag = other._tag;
+		switch (_tag)
+		{
+			case tag::none:
+			case tag::null:
+			case tag::boolean:
+			case tag::integer:
+			case tag::double_t:
+				break;
+			case tag::string:
+				_string->references.fetch_add(1, std::memory_order_relaxed);
+				break;
+			case tag::array:
+				_array->references.fetch_add(1, std::memory_order_relaxed);
+				break;
+			case tag::object:
+				_object->references.fetch_add(1, std::memory_order_relaxed);
+				break;
+		}
+	}
+
+	void node::move_from(node& other) noexcept
+	{
+		std::memcpy(&_integer, &other._integer, sizeof(_integer));
+		_tag	       = other._tag;
+		other._tag     = tag::none;
+		other._integer = 0;
+	}
+
+	void node::release() noexcept
+	{
+		switch (_tag)
+		{
+			case tag::none:
+			case tag::null:
+			case tag::boolean:
+			case tag::integer:
+			case tag::double_t:
+				break;
+			case tag::string:
+				release_storage(_string);
+				break;
+			case tag::array:
+				release_storage(_array);
+				break;
+			case tag::object:
+				release_storage(_object);
+				break;
+		}
+
+		_tag	 = tag::none;
+		_integer = 0;
+	}
+
+	void node::reset(tag new_tag, std::pmr::memory_resource* resource)
+	{
+		this->release();
+		switch (new_tag)
+		{
+			case tag::string:
+				_string = make_storage<std::pmr::string>(resource, resource);
+				break;
+			case tag::array:
+				_array = make_storage<ljson::array>(resource, resource);
+				break;
+			case tag::object:
+				_object = make_storage<ljson::object>(resource, resource);
+				break;
+			case tag::none:
+			case tag::null:
+			case tag::boolean:
+			case tag::integer:
+			case tag::double_t:
+				break;
+		}
+		_tag = new_tag;
+	}
+
+	void node::set_value(const class value& value, std::pmr::memory_resource* resource)
+	{
+		this->release();
+		if (auto string = std::get_if<std::string>(&value._value))
+		{
+			this->set_string(*string, resource);
+		}
+		else if (auto number = std::get_if<double>(&value._value))
+		{
+			_double = *number;
+			_tag	= tag::double_t;
+		}
+		else if (auto integer = std::get_if<int64_t>(&value._value))
+		{
+			_integer = *integer;
+			_tag	 = tag::integer;
+		}
+		else if (auto boolean = std::get_if<bool>(&value._value))
+		{
+			_boolean = *boolean;
+			_tag	 = tag::boolean;
+		}
+		else if (std::holds_alternative<null_type>(value._value))
+		{
+			_tag = tag::null;
+		}
+	}
+
+	void node::set_string(std::string_view string, std::pmr::memory_resource* resource)
+	{
+		this->release();
+		_string = make_storage<std::pmr::string>(resource, string, resource);
+		_tag	= tag::string;
+	}
+
+	class value node::get_value() const
+	{
+		switch (_tag)
+		{
+			case tag::null:
+				return ljson::value(ljson::null);
+			case tag::boolean:
+				return ljson::value(_boolean);
+			case tag::integer:
+				return ljson::value(_integer);
+			case tag::double_t:
+				return ljson::value(_double);
+			case tag::string:
+				return ljson::value(std::string(_string->data));
+			case tag::none:
+			case tag::array:
+			case tag::object:
+				break;
+		}
+
+		return ljson::value();
+	}
+
+	template<typename container_or_node_type>
+	node::node(const container_or_node_type& node_value) noexcept
+	{
+		this->setting_allowed_node_type(node_value);
+	}
+
+	template<typename container_or_node_type>
+	constexpr void node::setting_allowed_node_type(const container_or_node_type& node_value) noexcept
+	{
+		if constexpr (is_value_container<container_or_node_type>)
+		{
+			this->reset(tag::array);
+
+			if constexpr (requires { node_value.size(); })
+				_array->data.reserve(node_value.size());
+
+			for (const auto& val : node_value)
+				_array->data.emplace_back(val);
+		}
+		else if constexpr (is_key_value_container<container_or_node_type>)
+		{
+			this->reset(tag::object);
+			_object->data.reserve(node_value.size());
+
+			for (const auto& [key, val] : node_value)
+				_object->data.insert(key, ljson::node(val));
+		}
+		else if constexpr (std::is_same_v<container_or_node_type, ljson::node>)
+		{
+			*this = node_value;
+		}
+		else if constexpr (std::is_same_v<container_or_node_type, std::string> || std::is_same_v<container_or_node_type, const char*>)
+		{
+			this->set_string(node_value, std::pmr::get_default_resource());
+		}
+		else if constexpr (is_allowed_node_type<container_or_node_type>)
+		{
+			this->set_value(ljson::value(node_value));
+		}
+		else
+		{
+			static_assert(false && "unsupported type in the ljson::node constructor");
+		}
+	}
+
+	node::node(object_pairs pairs) : _object(make_storage<ljson::object>(std::pmr::get_default_resource())), _tag(tag::object)
+	{
+		*this += pairs;
+	}
+
+	node::node(array_values values) : _array(make_storage<ljson::array>(std::pmr::get_default_resource())), _tag(tag::array)
+	{
+		*this += values;
+	}
+
+	expected<class ljson::node, error> node::add_array_to_key(std::string_view key)
+	{
+		if (not this->is_object())
+			return unexpected(error(error_type::wrong_type, "wrong type: trying to add array to an object node"));
+
+		auto obj = &_object->data;
+		return obj->insert(key, ljson::node(node_type::array));
+	}
+
+	expected<class ljson::node, error> node::add_object_to_array()
+	{
+		if (not this->is_array())
+			return unexpected(error(error_type::wrong_type, "wrong type: trying to add object to an array node"));
+
+		auto arr = &_array->data;
+		arr->push_back(ljson::node(node_type::object));
+		return arr->back();
+	}
+
+	expected<class ljson::node, error> node::add_node_to_array(const ljson::node& node)
+	{
+		if (not this->is_array())
+			return unexpected(error(error_type::wrong_type, "wrong type: trying to add node to an array node"));
+
+		auto arr = &_array->data;
+		arr->push_back(node);
+
+		return arr->back();
+	}
+
+	expected<class ljson::node, error> node::add_node_to_array(ljson::node&& node)
+	{
+		if (not this->is_array())
+			return unexpected(error(error_type::wrong_type, "wrong type: trying to add node to an array node"));
+
+		auto arr = &_array->data;
+		arr->push_back(std::move(node));
+
+		return arr->back();
+	}
+
+	expected<class ljson::node, error> node::add_node_to_array(const size_t index, const ljson::node& node)
+	{
+		if (not this->is_array())
+			return unexpected(error(error_type::wrong_type, "wrong type: trying to add node to an array node"));
+
+		auto arr = &_array->data;
+		if (index >= arr->size())
+			return unexpected(
+			    error(error_type::wrong_type, "wrong type: trying to add node to an array node at an out-of-band index"));
+
+		(*arr)[index] = node;
+
+		return (*arr)[index];
+	}
+
+	expected<class ljson::node, error> node::add_node_to_array(const size_t index, ljson::node&& node)
+	{
+		if (not this->is_array())
+			return unexpected(error(error_type::wrong_type, "wrong type: trying to add node to an array node"));
+
+		auto arr = &_array->data;
+		if (index >= arr->size())
+			return unexpected(
+			    error(error_type::wrong_type, "wrong type: trying to add node to an array node at an out-of-band index"));
+
+		(*arr)[index] = std::move(node);
+
+		return (*arr)[index];
+	}
+
+	expected<class ljson::node, error> node::add_object_to_key(std::string_view key)
+	{
+		if (not this->is_object())
+			return unexpected(error(error_type::wrong_type, "wrong type: trying to add object to an object node"));
+
+		auto obj = &_object->data;
+		return obj->insert(key, ljson::node(node_type::object));
+	}
+
+	expected<class ljson::node, error> node::add_node_to_key(std::string_view key, const ljson::node& node)
+	{
+		if (not this->is_object())
+			return unexpected(error(error_type::wrong_type, "wrong type: trying to add node to an object node"));
+
+		auto obj = &_object->data;
+		return obj->insert(key, node);
+	}
+
+	expected<class ljson::node, error> node::add_node_to_key(std::string_view key, ljson::node&& node)
+	{
+		if (not this->is_object())
+			return unexpected(error(error_type::wrong_type, "wrong type: trying to add node to an object node"));
+
+		auto obj = &_object->data;
+		return obj->insert(key, std::move(node));
+	}
+
+	template<typename container_or_node_type>
+	expected<class ljson::node, error> node::insert(std::string_view key, container_or_node_type&& value)
+	{
+		using type = std::remove_cvref_t<container_or_node_type>;
+
+		if constexpr (std::is_same_v<type, ljson::node>)
+			return this->add_node_to_key(key, std::forward<container_or_node_type>(value));
+		else if constexpr (std::is_array_v<type>)
+			return this->add_node_to_key(key, ljson::node(static_cast<const char*>(value)));
+		else
+			return this->add_node_to_key(key, ljson::node(value));
+	}
+
+	template<typename container_or_node_type>
+	expected<class ljson::node, error> node::push_back(container_or_node_type&& value)
+	{
+		using type = std::remove_cvref_t<container_or_node_type>;
+
+		if constexpr (std::is_same_v<type, ljson::node>)
+			return this->add_node_to_array(std::forward<container_or_node_type>(value));
+		else if constexpr (std::is_array_v<type>)
+			return this->add_node_to_array(ljson::node(static_cast<const char*>(value)));
+		else
+			return this->add_node_to_array(ljson::node(value));
+	}
+
+	template<typename... args_t>
+	ljson::node& node::emplace_back(args_t&&... args)
+	{
+		if (not this->is_array())
+			throw error(error_type::wrong_type, "wrong type: trying to add node to an array node");
+
+		return _array->data.emplace_back(std::forward<args_t>(args)...);
+	}
+
+	void node::reserve(size_t size)
+	{
+		if (this->is_array())
+			_array->data.reserve(size);
+		else if (this->is_object())
+			_object->data.reserve(size);
+		else
+			throw error(error_type::wrong_type,
+			    error::lazy_message{"wrong type: trying to reserve room in a '{}' node", this->type_literal()});
+	}
+
+	size_t node::capacity() const noexcept
+	{
+		if (this->is_array())
+			return _array->data.capacity();
+		else if (this->is_object())
+			return _object->data.capacity();
+		else
+			return 0;
+	}
+
+	void node::shrink_to_fit()
+	{
+		if (this->is_array())
+			_array->data.shrink_to_fit();
+		else if (this->is_object())
+			_object->data.shrink_to_fit();
+	}
+
+	expected<class ljson::node, error> node::add_value_to_key(std::string_view key, const class value& value)
+	{
+		if (not this->is_object())
+			return unexpected(error(error_type::wrong_type, "wrong type: trying to add value to an object node"));
+
+		auto obj = &_object->data;
+		return obj->insert(key, ljson::node(value));
+	}
+
+	expected<class ljson::node, error> node::add_value_to_array(const class value& value)
+	{
+		if (not this->is_array())
+			return unexpected(error(error_type::wrong_type, "wrong type: trying to add value to an array node"));
+
+		auto arr = &_array->data;
+		arr->push_back(ljson::node(value));
+		return arr->back();
+	}
+
+	expected<class ljson::node, error> node::add_value_to_array(const size_t index, const class value& value)
+	{
+		if (not this->is_array())
+			return unexpected(error(error_type::wrong_type, "wrong type: trying to add value to an array node"));
+
+		auto arr = &_array->data;
+		if (index >= arr->size())
+			return unexpected(
+			    error(error_type::wrong_type, "wrong type: trying to add value to an array node at an out-of-band index"));
+
+		(*arr)[index] = ljson::node(value);
+
+		return (*arr)[index];
+	}
+
+	expected<std::shared_ptr<const class value>, error> node::try_as_value() const
+	{
+		if (not this->is_value())
+			return unexpected(error(error_type::wrong_type,
+			    error::lazy_message{"wrong type: trying to cast a '{}' node to a value", this->type_literal()}));
+
+		return std::make_shared<const class value>(this->get_value());
+	}
+
+	expected<std::shared_ptr<ljson::array>, error> node::try_as_array() const noexcept
+	{
+		if (not this->is_array())
+			return unexpected(error(error_type::wrong_type,
+			    error::lazy_message{"wrong type: trying to cast a '{}' node to an array", this->type_literal()}));
+
+		_array->references.fetch_add(1, std::memory_order_relaxed);
+		return std::shared_ptr<ljson::array>(&_array->data, [storage = _array](ljson::array*) { release_storage(storage); });
+	}
+
+	expected<std::shared_ptr<ljson::object>, error> node::try_as_object() const noexcept
+	{
+		if (not this->is_object())
+			return unexpected(error(error_type::wrong_type,
+			    error::lazy_message{"wrong type: trying to cast a '{}' node to an object", this->type_literal()}));
+
+		_object->references.fetch_add(1, std::memory_order_relaxed);
+		return std::shared_ptr<ljson::object>(&_object->data, [storage = _object](ljson::object*) { release_storage(storage); });
+	}
+
+	expected<std::reference_wrapper<ljson::array>, error> node::try_as_array_ref() const noexcept
+	{
+		if (not this->is_array())
+			return unexpected(error(error_type::wrong_type,
+			    error::lazy_message{"wrong type: trying to cast a '{}' node to an array", this->type_literal()}));
+
+		return std::ref(_array->data);
+	}
+
+	expected<std::reference_wrapper<ljson::object>, error> node::try_as_object_ref() const noexcept
+	{
+		if (not this->is_object())
+			return unexpected(error(error_type::wrong_type,
+			    error::lazy_message{"wrong type: trying to cast a '{}' node to an object", this->type_literal()}));
+
+		return std::ref(_object->data);
+	}
+
+	ljson::array& node::as_array_ref() const
+	{
+		auto ok = this->try_as_array_ref();
+		if (not ok)
+			throw ok.error();
+
+		return ok.value();
+	}
+
+	ljson::object& node::as_object_ref() const
+	{
+		auto ok = this->try_as_object_ref();
+		if (not ok)
+			throw ok.error();
+
+		return ok.value();
+	}
+
+	std::shared_ptr<const class value> node::as_value() const
+	{
+		auto ok = this->try_as_value();
+		if (not ok)
+			throw ok.error();
+
+		return ok.value();
+	}
+
+	std::shared_ptr<ljson::array> node::as_array() const
+	{
+		auto ok = this->try_as_array();
+		if (not ok)
+			throw ok.error();
+
+		return ok.value();
+	}
+
+	std::shared_ptr<ljson::object> node::as_object() const
+	{
+		auto ok = this->try_as_object();
+		if (not ok)
+			throw ok.error();
+
+		return ok.value();
+	}
+
+	bool node::is_value() const noexcept
+	{
+		return _tag != tag::array && _tag != tag::object;
+	}
+
+	bool node::is_array() const noexcept
+	{
+		return _tag == tag::array;
+	}
+
+	bool node::is_object() const noexcept
+	{
+		return _tag == tag::object;
+	}
+
+	bool node::is_string() const noexcept
+	{
+		return _tag == tag::string;
+	}
+
+	bool node::is_integer() const noexcept
+	{
+		return _tag == tag::integer;
+	}
+
+	bool node::is_double() const noexcept
+	{
+		return _tag == tag::double_t;
+	}
+
+	bool node::is_number() const noexcept
+	{
+		return _tag == tag::integer || _tag == tag::double_t;
+	}
+
+	bool node::is_boolean() const noexcept
+	{
+		return _tag == tag::boolean;
+	}
+
+	bool node::is_null() const noexcept
+	{
+		return _tag == tag::null;
+	}
+
+	node_type node::type() const noexcept
+	{
+		if (this->is_value())
+			return node_type::value;
+		else if (this->is_array())
+			return node_type::array;
+		else
+			return node_type::object;
+	}
+
+	std::string node::type_name() const noexcept
+	{
+		return this->type_literal();
+	}
+
+	const char* node::type_literal() const noexcept
+	{
+		if (this->is_value())
+			return "node value";
+		else if (this->is_array())
+			return "node array";
+		else
+			return "node object";
+	}
+
+	const char* node::value_type_literal() const noexcept
+	{
+		switch (_tag)
+		{
+			case tag::string:
+				return "string";
+			case tag::boolean:
+				return "boolean";
+			case tag::null:
+				return "null";
+			case tag::double_t:
+				return "double";
+			case tag::integer:
+				return "integer";
+			case tag::none:
+				return "none";
+			case tag::array:
+			case tag::object:
+				break;
+		}
+
+		return "unknown";
+	}
+
+	error node::cast_error(const char* target) const noexcept
+	{
+		// built from the tag alone, a miss on a string node doesn't copy the string
+		if (not this->is_value())
+			return error(error_type::wrong_type,
+			    error::lazy_message{"wrong type: trying to cast a '{}' node to a value", this->type_literal()});
+
+		return error(error_type::wrong_type,
+		    error::lazy_message{"wrong type: trying to cast a '{}' value to '{}'", this->value_type_literal(), target});
+	}
+
+	expected<std::string, error> node::try_as_string() const noexcept
+	{
+		if (_tag == tag::string)
+			return std::string(_string->data);
+
+		return unexpected(this->cast_error("string"));
+	}
+
+	expected<std::string_view, error> node::try_as_string_view() const noexcept
+	{
+		if (_tag == tag::string)
+			return std::string_view(_string->data);
+
+		return unexpected(this->cast_error("string"));
+	}
+
+	expected<int64_t, error> node::try_as_integer() const noexcept
+	{
+		if (_tag == tag::integer)
+			return _integer;
+
+		return unexpected(this->cast_error("integer"));
+	}
+
+	expected<double, error> node::try_as_double() const noexcept
+	{
+		if (_tag == tag::double_t)
+			return _double;
+
+		return unexpected(this->cast_error("double"));
+	}
+
+	expected<double, error> node::try_as_number() const noexcept
+	{
+		if (_tag == tag::double_t)
+			return _double;
+		else if (_tag == tag::integer)
+			return static_cast<double>(_integer);
+
+		return unexpected(this->cast_error("number"));
+	}
+
+	expected<bool, error> node::try_as_boolean() const noexcept
+	{
+		if (_tag == tag::boolean)
+			return _boolean;
+
+		return unexpected(this->cast_error("boolean"));
+	}
+
+	expected<null_type, error> node::try_as_null() const noexcept
+	{
+		if (_tag == tag::null)
+			return ljson::null;
+
+		return unexpected(this->cast_error("null"));
+	}
+
+	std::string node::as_string() const
+	{
+		auto ok = this->try_as_string();
+		if (not ok)
+			throw ok.error();
+		return ok.value();
+	}
+
+	template<typename T>
+	expected<T, error> node::try_get() const noexcept
+	{
+		if constexpr (std::is_same_v<T, bool>)
+			return this->try_as_boolean();
+		else if constexpr (std::is_same_v<T, std::string>)
+			return this->try_as_string();
+		else if constexpr (std::is_same_v<T, std::string_view>)
+			return this->try_as_string_view();
+		else if constexpr (std::is_same_v<T, null_type>)
+			return this->try_as_null();
+		else if constexpr (std::is_floating_point_v<T>)
+		{
+			auto ok = this->try_as_number();
+			if (not ok)
+				return unexpected(ok.error());
+
+			return static_cast<T>(ok.value());
+		}
+		else if constexpr (std::is_integral_v<T>)
+		{
+			auto ok = this->try_as_integer();
+			if (not ok)
+				return unexpected(ok.error());
+
+			if (not std::in_range<standard_integer_t<T>>(ok.value()))
+				return unexpected(error(error_type::number_out_of_range,
+				    "number out of range: {} doesn't fit in a {} byte integer", ok.value(), sizeof(T)));
+
+			return static_cast<T>(ok.value());
+		}
+		else
+		{
+			static_assert(false && "unsupported type in ljson::node::try_get");
+		}
+	}
+
+	template<typename T>
+	T node::get() const
+	{
+		auto ok = this->try_get<T>();
+		if (not ok)
+			throw ok.error();
+		return ok.value();
+	}
+
+	std::string_view node::as_string_view() const
+	{
+		auto ok = this->try_as_string_view();
+		if (not ok)
+			throw ok.error();
+		return ok.value();
+	}
+
+	int64_t node::as_integer() const
+	{
+		auto ok = this->try_as_integer();
+		if (not ok)
+			throw ok.error();
+		return ok.value();
+	}
 
-						return monostate();
-					}
+	double node::as_double() const
+	{
+		auto ok = this->try_as_double();
+		if (not ok)
+			throw ok.error();
+		return ok.value();
+	}
 
-					static expected<monostate, error> fill_array_data(struct parsing_data& data)
-					{
-						auto ok = data.json_objs.top().push_back(data.value);
-						if (not ok)
-						{
-							return unexpected(error(
-							    error_type::parsing_error, "internal parsing error\n[adding value to array]"));
-						}
+	double node::as_number() const
+	{
+		auto ok = this->try_as_number();
+		if (not ok)
+			throw ok.error();
+		return ok.value();
+	}
 
-						return monostate();
-					}
+	bool node::as_boolean() const
+	{
+		auto ok = this->try_as_boolean();
+		if (not ok)
+			throw ok.error();
+		return ok.value();
+	}
 
-					static bool run_till_end_of_statement(struct parsing_data& data)
-					{
-						if (data.hierarchy.empty())
-							return false;
-						else if (data.hierarchy.top().first != json_syntax::maybe_empty_space_after)
-							return false;
-						else if (data.line[data.i] == ',' || data.line[data.i] == '\n')
-						{
-							data.hierarchy.pop();
-							if (not data.hierarchy.empty() && data.hierarchy.top().first == json_syntax::column)
-								data.hierarchy.pop();
+	null_type node::as_null() const
+	{
+		auto ok = this->try_as_null();
+		if (not ok)
+			throw ok.error();
+		return ok.value();
+	}
 
-							if (not data.keys.empty())
-							{
-								data.keys.top().first.clear();
-								data.keys.top().second = key_type::none;
-							}
-							return true;
-						}
-						else
-							return false;
-					}
-			};
+	value_type node::valuetype() const noexcept
+	{
+		if (not this->is_value())
+			return value_type::none;
+		return this->get_value().type();
+	}
 
-			struct closing_bracket {
-					static expected<bool, error> handle_closing_bracket(struct parsing_data& data)
-					{
-						if (data.line[data.i] != '}' || value::is_string(data))
-							return false;
+	std::string node::value_type_name() const noexcept
+	{
+		if (not this->is_value())
+			return "none";
+		return this->get_value().type_name();
+	}
 
-						if (not data.hierarchy.empty() &&
-						    data.hierarchy.top().first == json_syntax::opening_bracket)
-							data.hierarchy.pop();
-						else
-						{
-							if (not data.hierarchy.empty())
-								return unexpected(error(error_type::parsing_error,
-								    std::format("error at: {}, hierarchy.size: {}: line_num: {}, line: {}",
-									data.line[data.i], data.hierarchy.size(),
-									data.hierarchy.top().second, data.line)));
-							else
-								return unexpected(error(error_type::parsing_error,
-								    std::format("extra closing bracket at line: {}", data.line_number)));
-						}
+	std::string node::stringify() const noexcept
+	{
+		if (this->is_value())
+			return this->get_value().stringify();
+		else
+			return this->dump_to_string();
+	}
 
-						return true;
-					}
-			};
+	bool node::contains(std::string_view key) const noexcept
+	{
+		if (not this->is_object())
+			return false;
 
-			struct syntax_error {
-					static expected<bool, error> handle_syntax_error(struct parsing_data& data)
-					{
-						if (end_statement::is_end_statement(data))
-							return false;
-						return unexpected(
-						    error(error_type::parsing_error, std::format("syntax error: line: '{}'\n[error]: {}",
-											 data.line, expected_x_but_found_y(data))));
-					}
+		return _object->data.contains(key);
+	}
 
-					static std::string expected_x_but_found_y(const struct parsing_data& data)
-					{
-						if (data.hierarchy.empty())
-							return std::format("expected '{{' but found '{}'", data.line[data.i]);
+	class node& node::at(std::string_view object_key) const
+	{
+		if (not this->is_object())
+			throw error(error_type::wrong_type,
+			    error::lazy_message{"wrong type: trying to cast a '{}' node to an object", this->type_literal()});
 
-						switch (data.hierarchy.top().first)
-						{
-							case json_syntax::array:
-								return std::format(
-								    "expected 'array values' but found '{}'", data.line[data.i]);
-							case json_syntax::object:
-								return std::format(
-								    "expected 'object key/value pairs' but found '{}'", data.line[data.i]);
-							case json_syntax::opening_bracket:
-								return std::format(
-								    "expected [EOF, key, array, object] but found '{}'", data.line[data.i]);
-							case json_syntax::column:
-								return std::format("expected 'value' but found '{}'", data.line[data.i]);
-							case json_syntax::string_value:
-								return std::format(
-								    "expected 'string value' but found '{}'", data.line[data.i]);
-							case json_syntax::quotes_1:
-								return std::format(
-								    "expected [string value, quote] but found '{}'", data.line[data.i]);
-							case json_syntax::quotes_2:
-								return std::format(
-								    "expected [string value, quote] but found '{}'", data.line[data.i]);
-							case json_syntax::closing_bracket:
-								return std::format("expected 'EOF' but found '{}'", data.line[data.i]);
-							case json_syntax::flush_value:
-							case json_syntax::maybe_empty_space_after:
-							default:
-								return std::format("unexpected syntax: found '{}'", data.line[data.i]);
-						}
-					}
-			};
-	};
+		auto itr = _object->data.find(object_key);
+		if (itr == _object->data.end())
+			throw error(error_type::key_not_found, std::format("key: '{}' not found", object_key));
+		return itr->second;
+	}
 
-	node::node() : _node(std::make_shared<ljson::object>())
+	class node& node::at(const size_t array_index) const
 	{
+		if (not this->is_array())
+			throw error(error_type::wrong_type,
+			    error::lazy_message{"wrong type: trying to cast a '{}' node to an array", this->type_literal()});
+
+		if (array_index >= _array->data.size())
+			throw error(error_type::key_not_found, "index: '{}' not found", array_index);
+
+		return _array->data[array_index];
 	}
 
-	node::node(enum node_type type)
+	expected<std::reference_wrapper<ljson::node>, ljson::error> node::try_at(std::string_view object_key) const noexcept
 	{
-		switch (type)
-		{
-			case node_type::value:
-				_node = std::make_shared<class value>();
-				break;
-			case node_type::array:
-				_node = std::make_shared<ljson::array>();
-				break;
-			case ljson::node_type::object:
-				_node = std::make_shared<ljson::object>();
-				break;
-		}
+		if (not this->is_object())
+			return unexpected(error(error_type::wrong_type,
+			    error::lazy_message{"wrong type: trying to cast a '{}' node to an object", this->type_literal()}));
+
+		auto itr = _object->data.find(object_key);
+		if (itr == _object->data.end())
+			return unexpected(error(error_type::key_not_found, std::format("key: '{}' not found", object_key)));
+
+		return std::ref(itr->second);
 	}
 
-	template<typename container_or_node_type>
-	node::node(const container_or_node_type& node_value) noexcept
+	expected<std::reference_wrapper<ljson::node>, ljson::error> node::try_at(const size_t array_index) const noexcept
 	{
-		this->setting_allowed_node_type(node_value);
+		if (not this->is_array() || array_index >= _array->data.size())
+			return unexpected(error(error_type::key_not_found, "index: '{}' not found", array_index));
+
+		return std::ref(_array->data[array_index]);
 	}
 
-	template<typename is_allowed_node_type>
-	constexpr std::variant<class value, ljson::node> node::handle_allowed_node_types(const is_allowed_node_type& value) noexcept
+	template<typename container_or_node_type>
+	class node& node::operator=(const container_or_node_type& node_value) noexcept
 	{
-		if constexpr (std::is_same<is_allowed_node_type, class value>::value)
-		{
-			return value;
-		}
-		else if constexpr (std::is_same<is_allowed_node_type, bool>::value)
-		{
-			return ljson::value(value);
-		}
-		else if constexpr (std::is_arithmetic<is_allowed_node_type>::value)
-		{
-			if constexpr (std::is_floating_point_v<is_allowed_node_type>)
-				return ljson::value(value);
-			else
-				return ljson::value(value);
-		}
-		else if constexpr (std::is_same<is_allowed_node_type, std::string>::value)
-		{
-			return ljson::value(value);
-		}
-		else if constexpr (std::is_same<is_allowed_node_type, const char*>::value)
-		{
-			return ljson::value(value);
-		}
-		else if constexpr (std::is_same<is_allowed_node_type, null_type>::value)
-		{
-			return ljson::value(ljson::null);
-		}
-		else if constexpr (std::is_same<is_allowed_node_type, ljson::node>::value)
+		if constexpr (std::is_same_v<container_or_node_type, ljson::node>)
 		{
-			return value;
+			if (this != &node_value)
+			{
+				this->setting_allowed_node_type(node_value);
+			}
 		}
 		else
 		{
-			static_assert(false && "unsupported value_type in function node::handle_allowed_node_types(...)");
+			this->setting_allowed_node_type(node_value);
 		}
+		return *this;
 	}
 
-	template<typename container_or_node_type>
-	constexpr void node::setting_allowed_node_type(const container_or_node_type& node_value) noexcept
+	class node& node::operator+=(object_pairs pairs)
 	{
-		if constexpr (is_value_container<container_or_node_type>)
-		{
-			_node = std::make_shared<ljson::array>();
+		if (not this->is_object())
+			throw error(error_type::wrong_type, "wrong type: trying to insert pairs to a non-object");
 
-			for (auto& val : node_value)
-			{
-				std::variant<class value, ljson::node> v = this->handle_allowed_node_types(val);
+		auto map = &_object->data;
+		for (const auto& [key, value] : pairs)
+			map->insert(key, value.get());
 
-				if (std::holds_alternative<class value>(v))
-				{
-					this->push_back(node(std::get<class value>(v)));
-				}
-				else
-				{
-					this->push_back(std::get<ljson::node>(v));
-				}
-			}
-		}
-		else if constexpr (is_key_value_container<container_or_node_type>)
-		{
-			_node = std::make_shared<ljson::object>();
+		return *this;
+	}
 
-			for (auto& [key, val] : node_value)
-			{
-				std::variant<class value, ljson::node> v = this->handle_allowed_node_types(val);
+	class node& node::operator+=(array_values values)
+	{
+		if (not this->is_array())
+			throw error(error_type::wrong_type, "wrong type: trying to insert pairs to a non-array");
 
-				if (std::holds_alternative<class value>(v))
-				{
-					this->insert(key, node(std::get<class value>(v)));
-				}
-				else
-				{
-					this->insert(key, std::get<ljson::node>(v));
-				}
-			}
-		}
-		else if constexpr (is_allowed_node_type<container_or_node_type>)
+		auto vector = &_array->data;
+		for (const auto& value : values)
+			vector->push_back(value.get());
+
+		return *this;
+	}
+
+	class node node::operator+(const node& other_node)
+	{
+		if (this->type() != other_node.type())
+			throw error(error_type::wrong_type, "trying to + two nodes with different types");
+
+		if (this->is_object())
 		{
-			std::variant<class value, ljson::node> n = this->handle_allowed_node_types(node_value);
-			if (std::holds_alternative<class value>(n))
+			ljson::node new_node(ljson::node_type::object);
+			for (const auto& [key, node] : this->as_object_ref())
 			{
-				_node = std::make_shared<class value>(std::get<class value>(n));
+				new_node.add_node_to_key(key, node);
 			}
-			else
+			for (const auto& [key, node] : other_node.as_object_ref())
 			{
-				_node = std::get<ljson::node>(n)._node;
+				new_node.add_node_to_key(key, node);
 			}
-		}
-		else
-		{
-			static_assert(false && "unsupported type in the ljson::node constructor");
-		}
-	}
 
-	void node::handle_std_any(const std::any& any_value, std::function<void(std::any)> insert_func)
-	{
-		if (any_value.type() == typeid(ljson::node))
-		{
-			auto val = std::any_cast<ljson::node>(any_value);
-			insert_func(val);
+			return new_node;
 		}
-		else
+		else if (this->is_array())
 		{
-			class value value;
-			if (any_value.type() == typeid(bool))
+			ljson::node new_node(ljson::node_type::array);
+			for (const auto& node : this->as_array_ref())
 			{
-				auto val = std::any_cast<bool>(any_value);
-				value.set_value_type(val);
-				insert_func(value);
+				new_node.add_node_to_array(node);
 			}
-			else if (any_value.type() == typeid(double))
+			for (const auto& node : other_node.as_array_ref())
 			{
-				auto val = std::any_cast<double>(any_value);
-				value.set_value_type(val);
-				insert_func(value);
+				new_node.add_node_to_array(node);
 			}
-			else if (any_value.type() == typeid(int))
+
+			return new_node;
+		}
+		else
+		{
+			ljson::node new_node(this->type());
+
+			if (this->is_string())
 			{
-				auto val = std::any_cast<int>(any_value);
-				value.set_value_type(val);
-				insert_func(value);
+				new_node = this->as_string() + other_node.as_string();
 			}
-			else if (any_value.type() == typeid(float))
+			else if (this->is_number())
 			{
-				auto val = std::any_cast<float>(any_value);
-				value.set_value_type(val);
-				insert_func(value);
+				new_node = this->as_number() + other_node.as_number();
 			}
-			else if (any_value.type() == typeid(const char*))
+			else
 			{
-				auto val = std::any_cast<const char*>(any_value);
-				value.set_value_type(val);
-				insert_func(value);
+				throw error(
+				    error_type::wrong_type, "trying to + two nodes with values that are neither a number nor string");
 			}
-			else if (any_value.type() == typeid(std::string))
+
+			return new_node;
+		}
+	}
+
+	template<typename container_or_node_type>
+	void node::set(const container_or_node_type& node_value) noexcept
+	{
+		this->setting_allowed_node_type(node_value);
+	}
+
+	void node::set(ljson::node&& node_value) noexcept
+	{
+		*this = std::move(node_value);
+	}
+
+	/**
+	 * @class serializer
+	 * @brief writes ljson::node as json text into a contiguous buffer. when a sink is given the buffer is
+	 * handed to it every time it grows past flush_size, with std::nullptr_t the buffer is the final output
+	 */
+	template<typename sink_type>
+	class serializer {
+		private:
+			std::string&		   _buffer;
+			sink_type&		   _sink;
+			const std::pair<char, int> _indent_conf;
+			const bool		   _compact;
+
+			void flush_if_full()
 			{
-				auto val = std::any_cast<std::string>(any_value);
-				value.set_value_type(val);
-				insert_func(value);
+				if constexpr (not std::is_same_v<sink_type, std::nullptr_t>)
+				{
+					if (_buffer.size() >= flush_size)
+						this->flush();
+				}
 			}
-			else if (any_value.type() == typeid(ljson::null_type))
+
+			void write_new_line(int indent)
 			{
-				value.set_value_type(ljson::null);
-				insert_func(value);
+				if (_compact)
+					return;
+
+				_buffer += '\n';
+				_buffer.append(static_cast<size_t>(indent), _indent_conf.first);
 			}
-			else
+
+		public:
+			static constexpr size_t flush_size = 64 * 1024;
+
+			serializer(std::string& buffer, sink_type& sink, const std::pair<char, int>& indent_conf,
+			    dump_style style = dump_style::pretty)
+			    : _buffer(buffer), _sink(sink), _indent_conf(indent_conf), _compact(style == dump_style::compact)
 			{
-				throw error(error_type::wrong_type,
-				    std::string("unknown type given to ljson::node constructor: ") + any_value.type().name());
 			}
-		}
-	}
-
-	node::node(const std::initializer_list<std::pair<std::string, std::any>>& pairs) : _node(std::make_shared<ljson::object>())
-	{
-		std::string key;
-		auto	    map = this->as_object();
 
-		auto insert_func = [&](const std::any& value)
-		{
-			if (value.type() == typeid(ljson::node))
+			void write(const ljson::node& node, int indent)
 			{
-				auto val = std::any_cast<ljson::node>(value);
-				map->insert(key, val);
+				switch (node._tag)
+				{
+					case ljson::node::tag::object:
+					{
+						_buffer += '{';
+						bool first = true;
+						for (const auto& [key, child] : node._object->data)
+						{
+							if (not first)
+								_buffer += ',';
+							first = false;
+
+							this->write_new_line(indent + _indent_conf.second);
+							_buffer += '"';
+							_buffer += key;
+							_buffer += _compact ? "\":" : "\": ";
+							this->write(child, indent + _indent_conf.second);
+							this->flush_if_full();
+						}
+						this->write_new_line(indent);
+						_buffer += '}';
+						break;
+					}
+					case ljson::node::tag::array:
+					{
+						_buffer += '[';
+						bool first = true;
+						for (const auto& element : node._array->data)
+						{
+							if (not first)
+								_buffer += ',';
+							first = false;
+
+							this->write_new_line(indent + _indent_conf.second);
+							this->write(element, indent + _indent_conf.second);
+							this->flush_if_full();
+						}
+						this->write_new_line(indent);
+						_buffer += ']';
+						break;
+					}
+					case ljson::node::tag::string:
+						_buffer += '"';
+						_buffer += node._string->data;
+						_buffer += '"';
+						break;
+					case ljson::node::tag::integer:
+					case ljson::node::tag::double_t:
+					case ljson::node::tag::boolean:
+					case ljson::node::tag::null:
+					case ljson::node::tag::none:
+						node.get_value().stringify_to(_buffer);
+						break;
+				}
 			}
-			else
+
+			void flush()
 			{
-				auto val = std::any_cast<class value>(value);
-				map->insert(key, ljson::node(val));
+				if constexpr (not std::is_same_v<sink_type, std::nullptr_t>)
+				{
+					const std::string& chunk = _buffer;
+					if (not chunk.empty())
+						_sink(chunk);
+
+					_buffer.clear();
+				}
 			}
-		};
+	};
 
-		for (const auto& pair : pairs)
-		{
-			key = pair.first;
-			this->handle_std_any(pair.second, insert_func);
-			key.clear();
-		}
+	template<typename out_func_type>
+	void node::dump(out_func_type&& out_func, const std::pair<char, int>& indent_conf, int indent) const
+	{
+		std::string					   buffer;
+		serializer<std::remove_reference_t<out_func_type>> writer(buffer, out_func, indent_conf);
+		writer.write(*this, indent);
+		writer.flush();
 	}
 
-	node::node(const std::initializer_list<std::any>& val) : _node(std::make_shared<ljson::array>())
+	template<typename out_func_type>
+	void node::dump(out_func_type&& out_func, dump_style style) const
 	{
-		auto vector = this->as_array();
-
-		auto insert_func = [&](const std::any& value)
-		{
-			if (value.type() == typeid(ljson::node))
-			{
-				auto val = std::any_cast<ljson::node>(value);
-				vector->push_back(val);
-			}
-			else
-			{
-				auto val = std::any_cast<class value>(value);
-				vector->push_back(ljson::node(val));
-			}
-		};
+		std::string					   buffer;
+		serializer<std::remove_reference_t<out_func_type>> writer(buffer, out_func, {' ', 4}, style);
+		writer.write(*this, 0);
+		writer.flush();
+	}
 
-		for (const auto& value : val)
-		{
-			this->handle_std_any(value, insert_func);
-		}
+	void node::dump_to_stdout(const std::pair<char, int>& indent_conf) const
+	{
+		this->dump([](const std::string& output) { std::cout.write(output.data(), static_cast<std::streamsize>(output.size())); },
+		    indent_conf);
 	}
 
-	expected<class ljson::node, error> node::add_array_to_key(const std::string& key)
+	std::string node::dump_to_string(const std::pair<char, int>& indent_conf) const
 	{
-		if (not this->is_object())
-			return unexpected(error(error_type::wrong_type, "wrong type: trying to add array to an object node"));
+		std::string		   data;
+		std::nullptr_t		   sink = nullptr;
+		serializer<std::nullptr_t> writer(data, sink, indent_conf);
+		writer.write(*this, 0);
 
-		auto obj = this->as_object();
-		return obj->insert(key, ljson::node(node_type::array));
+		return data;
 	}
 
-	expected<class ljson::node, error> node::add_object_to_array()
+	std::string node::dump_to_string(dump_style style) const
 	{
-		if (not this->is_array())
-			return unexpected(error(error_type::wrong_type, "wrong type: trying to add object to an array node"));
+		std::string		   data;
+		std::nullptr_t		   sink = nullptr;
+		serializer<std::nullptr_t> writer(data, sink, {' ', 4}, style);
+		writer.write(*this, 0);
 
-		auto arr = this->as_array();
-		arr->push_back(ljson::node(node_type::object));
-		return arr->back();
+		return data;
 	}
 
-	expected<class ljson::node, error> node::add_node_to_array(const ljson::node& node)
+	expected<monostate, error> node::dump_to_file(const std::filesystem::path& path, const std::pair<char, int>& indent_conf) const
 	{
-		if (not this->is_array())
-			return unexpected(error(error_type::wrong_type, "wrong type: trying to add node to an array node"));
+		std::ofstream file(path);
+		if (not file.is_open())
+			return unexpected(error(error_type::filesystem_error, std::strerror(errno)));
 
-		auto arr = this->as_array();
-		arr->push_back(node);
+		this->dump([&file](const std::string& output) { file.write(output.data(), static_cast<std::streamsize>(output.size())); },
+		    indent_conf);
+		file.close();
 
-		return arr->back();
+		return monostate();
 	}
 
-	expected<class ljson::node, error> node::add_node_to_array(const size_t index, const ljson::node& node)
+	expected<monostate, error> node::dump_to_file(const std::filesystem::path& path, dump_style style) const
 	{
-		if (not this->is_array())
-			return unexpected(error(error_type::wrong_type, "wrong type: trying to add node to an array node"));
-
-		auto arr = this->as_array();
-		if (index >= arr->size())
-			return unexpected(
-			    error(error_type::wrong_type, "wrong type: trying to add node to an array node at an out-of-band index"));
+		std::ofstream file(path);
+		if (not file.is_open())
+			return unexpected(error(error_type::filesystem_error, std::strerror(errno)));
 
-		(*arr)[index] = node;
+		this->dump([&file](const std::string& output) { file.write(output.data(), static_cast<std::streamsize>(output.size())); },
+		    style);
+		file.close();
 
-		return (*arr)[index];
+		return monostate();
 	}
 
-	expected<class ljson::node, error> node::add_object_to_key(const std::string& key)
+	parser::parser()
 	{
-		if (not this->is_object())
-			return unexpected(error(error_type::wrong_type, "wrong type: trying to add object to an object node"));
-
-		auto obj = this->as_object();
-		return obj->insert(key, ljson::node(node_type::object));
 	}
 
-	expected<class ljson::node, error> node::add_node_to_key(const std::string& key, const ljson::node& node)
+	template<typename handler_type>
+	expected<bool, error> parser::next_event(struct parsing_data& data, handler_type& handler)
 	{
-		if (not this->is_object())
-			return unexpected(error(error_type::wrong_type, "wrong type: trying to add node to an object node"));
+		while (true)
+		{
+			parser_syntax::skip_empty(data);
+			if (data.i >= data.raw_json.size())
+				return false;
 
-		auto obj = this->as_object();
-		return obj->insert(key, node);
+			const char ch = data.raw_json[data.i];
+			switch (data.state)
+			{
+				case json_syntax::root:
+					if (ch != '{')
+						return unexpected(parser_syntax::syntax_error(data, "'{'"));
+					data.i++;
+					if (auto ok = parser_syntax::value::open_container(data, handler, false); not ok)
+						return unexpected(ok.error());
+					return true;
+				case json_syntax::key_or_end:
+					if (ch == '"')
+					{
+						auto ok = parser_syntax::string::handle_string(data);
+						if (not ok)
+							return unexpected(ok.error());
+						data.state = json_syntax::column;
+						if (not handler.on_key(ok.value()))
+							return unexpected(parser_syntax::stopped_error(data));
+						return true;
+					}
+					else if (ch == '}')
+					{
+						if (auto ok = parser_syntax::closing_bracket::handle_closing_bracket(data, handler); not ok)
+							return unexpected(ok.error());
+						return true;
+					}
+					else if (ch == ',')
+						// a stray ',' where a key is expected is skipped, like the trailing one before '}'
+						data.i++;
+					else
+						return unexpected(parser_syntax::syntax_error(data, "[key, '}']"));
+					break;
+				case json_syntax::column:
+					if (ch != ':')
+						return unexpected(parser_syntax::syntax_error(data, "':'"));
+					data.i++;
+					data.state = json_syntax::value;
+					break;
+				case json_syntax::value_or_end:
+					if (ch == ']')
+					{
+						if (auto ok = parser_syntax::closing_bracket::handle_closing_bracket(data, handler); not ok)
+							return unexpected(ok.error());
+						return true;
+					}
+					[[fallthrough]];
+				case json_syntax::value:
+					if (parser_syntax::is_end_of_token(ch))
+						return unexpected(parser_syntax::syntax_error(data, "'value'"));
+					else if (auto ok = parser_syntax::value::handle_value(data, handler); not ok)
+						return unexpected(ok.error());
+					return true;
+				case json_syntax::end_statement:
+					if (ch == ',')
+					{
+						data.i++;
+						data.state = data.scopes.back() ? json_syntax::value_or_end : json_syntax::key_or_end;
+					}
+					else if (ch == (data.scopes.back() ? ']' : '}'))
+					{
+						if (auto ok = parser_syntax::closing_bracket::handle_closing_bracket(data, handler); not ok)
+							return unexpected(ok.error());
+						return true;
+					}
+					else
+						return unexpected(parser_syntax::syntax_error(data, data.scopes.back() ? "[',', ']']" : "[',', '}']"));
+					break;
+				case json_syntax::done:
+					// only whitespace may follow the root object
+					if (ch == '}' || ch == ']')
+						return unexpected(error(error_type::parsing_error, "extra closing bracket at line: {}",
+						    parser_syntax::line_number(data)));
+					return unexpected(error(error_type::parsing_error, "unexpected '{}' after the root object at line: {}", ch,
+					    parser_syntax::line_number(data)));
+			}
+		}
 	}
 
-	template<typename container_or_node_type>
-	expected<class ljson::node, error> node::insert(const std::string& key, const container_or_node_type& value)
+	template<typename handler_type>
+	expected<monostate, error> parser::parsing(struct parsing_data& data, handler_type& handler)
 	{
-		ljson::node n(value);
-		return this->add_node_to_key(key, n);
-	}
+		while (true)
+		{
+			auto ok = ljson::parser::next_event(data, handler);
+			if (not ok)
+				return unexpected(ok.error());
+			else if (not ok.value())
+				break;
+		}
 
-	template<typename container_or_node_type>
-	expected<class ljson::node, error> node::push_back(const container_or_node_type& value)
-	{
-		ljson::node n(value);
-		return this->add_node_to_array(n);
+		if (data.state != json_syntax::root && data.state != json_syntax::done)
+			return unexpected(parser_syntax::syntax_error(data, data.scopes.back() ? "']'" : "'}'"));
+
+		return monostate();
 	}
 
-	expected<class ljson::node, error> node::add_value_to_key(const std::string& key, const class value& value)
+	ljson::node parser::parse(const std::filesystem::path& path)
 	{
-		if (not this->is_object())
-			return unexpected(error(error_type::wrong_type, "wrong type: trying to add value to an object node"));
+		expected<ljson::node, error> ok = ljson::parser::try_parse(path);
+		if (not ok)
+			throw ok.error();
 
-		auto obj = this->as_object();
-		return obj->insert(key, ljson::node(value));
+		return ok.value();
 	}
 
-	expected<class ljson::node, error> node::add_value_to_array(const class value& value)
+	ljson::node parser::parse(const char* raw_json)
 	{
-		if (not this->is_array())
-			return unexpected(error(error_type::wrong_type, "wrong type: trying to add value to an array node"));
+		expected<ljson::node, error> ok = ljson::parser::try_parse(raw_json);
+		if (not ok)
+			throw ok.error();
 
-		auto arr = this->as_array();
-		arr->push_back(ljson::node(value));
-		return arr->back();
+		return ok.value();
 	}
 
-	expected<class ljson::node, error> node::add_value_to_array(const size_t index, const class value& value)
+	ljson::node parser::parse(const std::string& raw_json)
 	{
-		if (not this->is_array())
-			return unexpected(error(error_type::wrong_type, "wrong type: trying to add value to an array node"));
+		expected<ljson::node, error> ok = ljson::parser::try_parse(raw_json);
+		if (not ok)
+			throw ok.error();
 
-		auto arr = this->as_array();
-		if (index >= arr->size())
-			return unexpected(
-			    error(error_type::wrong_type, "wrong type: trying to add value to an array node at an out-of-band index"));
+		return ok.value();
+	}
 
-		(*arr)[index] = ljson::node(value);
+	ljson::node parser::parse(std::string_view raw_json)
+	{
+		expected<ljson::node, error> ok = ljson::parser::try_parse(raw_json);
+		if (not ok)
+			throw ok.error();
 
-		return (*arr)[index];
+		return ok.value();
 	}
 
-	expected<std::shared_ptr<class value>, error> node::try_as_value() const noexcept
+	ljson::node parser::parse(std::string_view raw_json, std::pmr::memory_resource* resource)
 	{
-		if (not this->is_value())
-			return unexpected(
-			    error(error_type::wrong_type, "wrong type: trying to cast a '{}' node to a value", this->type_name()));
+		expected<ljson::node, error> ok = ljson::parser::try_parse(raw_json, resource);
+		if (not ok)
+			throw ok.error();
 
-		return std::get<std::shared_ptr<class value>>(_node);
+		return ok.value();
 	}
 
-	expected<std::shared_ptr<ljson::array>, error> node::try_as_array() const noexcept
+	ljson::node parser::parse(std::span<const std::byte> raw_json)
 	{
-		if (not this->is_array())
-			return unexpected(
-			    error(error_type::wrong_type, "wrong type: trying to cast a '{} node to an array", this->type_name()));
+		expected<ljson::node, error> ok = ljson::parser::try_parse(raw_json);
+		if (not ok)
+			throw ok.error();
 
-		return std::get<std::shared_ptr<ljson::array>>(_node);
+		return ok.value();
 	}
 
-	expected<std::shared_ptr<ljson::object>, error> node::try_as_object() const noexcept
+	expected<ljson::node, error> parser::try_parse(std::string_view raw_json) noexcept
 	{
-		if (not this->is_object())
-			return unexpected(
-			    error(error_type::wrong_type, "wrong type: trying to cast a '{}' node to an object", this->type_name()));
-
-		return std::get<std::shared_ptr<ljson::object>>(_node);
+		return ljson::parser::try_parse(raw_json, std::pmr::get_default_resource());
 	}
 
-	std::shared_ptr<class value> node::as_value() const
+	expected<ljson::node, error> parser::try_parse(std::string_view raw_json, std::pmr::memory_resource* resource) noexcept
 	{
-		auto ok = this->try_as_value();
-		if (not ok)
-			throw ok.error();
+		struct parsing_data data;
+		data.raw_json = raw_json;
+		data.resource = resource;
 
-		return ok.value();
+		return ljson::parser::parse_tree(data);
 	}
 
-	std::shared_ptr<ljson::array> node::as_array() const
+	expected<ljson::node, error> parser::parse_tree(struct parsing_data& data) noexcept
 	{
-		auto ok = this->try_as_array();
+		ljson::node json_data = ljson::node(node_type::object, data.resource);
+
+		structural_index index;
+		if (data.raw_json.size() <= structural_index::max_size)
+		{
+			index.build(data.raw_json);
+			data.index = &index;
+			parser_syntax::estimate_sizes(data);
+		}
+
+		parser_syntax::dom_builder builder{data, json_data, {}, {}};
+		auto			   ok = ljson::parser::parsing(data, builder);
 		if (not ok)
-			throw ok.error();
+			return unexpected(ok.error());
 
-		return ok.value();
+		return json_data;
 	}
 
-	std::shared_ptr<ljson::object> node::as_object() const
+	expected<monostate, error> parser::validate(std::string_view raw_json) noexcept
 	{
-		auto ok = this->try_as_object();
+		if (parser_syntax::validator::is_valid(raw_json))
+			return monostate();
+
+		// run the event parser over the invalid input to find and describe the problem
+		struct parsing_data data;
+		data.raw_json = raw_json;
+
+		sax_handler handler;
+		auto	    ok = ljson::parser::parsing(data, handler);
 		if (not ok)
-			throw ok.error();
+			return unexpected(error(ok.error().value(), "{}, offset: {}", ok.error().message(), std::min(data.i, raw_json.size())));
 
-		return ok.value();
+		return monostate();
 	}
 
-	bool node::is_value() const noexcept
+	expected<monostate, error> parser::parse_elements(std::string_view raw_json, const structural_index& index,
+	    const struct array_chunk& chunk, bool first, ljson::node& array) noexcept
 	{
-		if (std::holds_alternative<std::shared_ptr<class value>>(_node))
-			return true;
-		else
-			return false;
+		struct parsing_data data;
+		data.raw_json = raw_json.substr(0, chunk.end);
+		data.i	      = chunk.begin;
+		data.index    = &index;
+		data.index_i  = chunk.index_i;
+		data.scopes.push_back(true);
+		data.state    = first ? json_syntax::value_or_end : json_syntax::value;
+
+		parser_syntax::dom_builder builder{data, array, {}, {}};
+		builder.json_objs.push(array);
+
+		while (true)
+		{
+			auto ok = ljson::parser::next_event(data, builder);
+			if (not ok)
+				return unexpected(ok.error());
+			else if (not ok.value())
+				break;
+		}
+
+		// the chunk has to end after a whole element (or a trailing comma) of the array
+		if (data.scopes.size() != 1 || (data.state != json_syntax::end_statement && data.state != json_syntax::value_or_end))
+		{
+			data.raw_json = raw_json;
+			return unexpected(parser_syntax::syntax_error(data, data.scopes.size() > 1 && not data.scopes.back() ? "'}'" : "']'"));
+		}
+
+		return monostate();
 	}
 
-	bool node::is_array() const noexcept
+	expected<ljson::node, error> parser::try_parse_parallel(std::string_view raw_json, size_t threads)
 	{
-		if (std::holds_alternative<std::shared_ptr<ljson::array>>(_node))
-			return true;
-		else
-			return false;
+		if (threads == 0)
+			threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+		if (threads == 1 || raw_json.size() < min_parallel_size || raw_json.size() > structural_index::max_size)
+			return ljson::parser::try_parse(raw_json);
+
+		ljson::node	    json_data = ljson::node(node_type::object);
+		struct parsing_data data;
+		data.raw_json = raw_json;
+
+		structural_index index;
+		index.build(raw_json);
+		data.index = &index;
+		parser_syntax::estimate_sizes(data);
+
+		// a few chunks per thread so a slow chunk doesn't leave the other threads idle
+		struct array_split split = parser_syntax::split_largest_array(data, threads * 4, min_parallel_size);
+		if (split.chunks.size() <= 1)
+		{
+			parser_syntax::dom_builder builder{data, json_data, {}, {}};
+			if (auto ok = ljson::parser::parsing(data, builder); not ok)
+				return unexpected(ok.error());
+
+			return json_data;
+		}
+
+		std::vector<ljson::node>		chunks;
+		std::vector<expected<monostate, error>> status(split.chunks.size());
+		std::atomic<size_t>			next_chunk = 0;
+		for (size_t i = 0; i < split.chunks.size(); i++)
+			chunks.emplace_back(node_type::array);
+
+		parser_syntax::skipping_builder builder{{data, json_data, {}, {}}, split};
+		expected<monostate, error>	ok;
+		{
+			std::vector<std::jthread> workers;
+			for (size_t worker = 0; worker < std::min(threads, split.chunks.size()); worker++)
+			{
+				workers.emplace_back(
+				    [&]()
+				    {
+					    for (size_t i = next_chunk++; i < split.chunks.size(); i = next_chunk++)
+						    status[i] = ljson::parser::parse_elements(raw_json, index, split.chunks[i], i == 0, chunks[i]);
+				    });
+			}
+
+			ok = ljson::parser::parsing(data, builder);
+		}
+
+		// an error in front of the array comes first in the input
+		if (not ok && not builder.target.is_array())
+			return unexpected(ok.error());
+
+		for (expected<monostate, error>& chunk_status : status)
+		{
+			if (not chunk_status)
+				return unexpected(chunk_status.error());
+		}
+
+		if (not ok)
+			return unexpected(ok.error());
+
+		ljson::array& array = builder.target.as_array_ref();
+		size_t	      size  = 0;
+		for (ljson::node& chunk : chunks)
+			size += chunk.as_array_ref().size();
+
+		array.reserve(size);
+		for (ljson::node& chunk : chunks)
+		{
+			for (ljson::node& element : chunk.as_array_ref())
+				array.push_back(std::move(element));
+		}
+
+		return json_data;
 	}
 
-	bool node::is_object() const noexcept
+	expected<ljson::node, error> parser::try_parse_parallel(const std::filesystem::path& path, size_t threads)
 	{
-		if (std::holds_alternative<std::shared_ptr<ljson::object>>(_node))
-			return true;
-		else
-			return false;
+		file_buffer file;
+		if (auto ok = file.open(path); not ok)
+			return unexpected(ok.error());
+
+		return ljson::parser::try_parse_parallel(file.view(), threads);
 	}
 
-	bool node::is_string() const noexcept
+	expected<ljson::node, error> parser::try_parse_parallel(const std::string& raw_json, size_t threads)
 	{
-		return not this->is_value() ? false : this->as_value()->is_string();
+		return ljson::parser::try_parse_parallel(std::string_view(raw_json), threads);
 	}
 
-	bool node::is_integer() const noexcept
+	expected<ljson::node, error> parser::try_parse_parallel(const char* raw_json, size_t threads)
 	{
-		return not this->is_value() ? false : this->as_value()->is_integer();
+		assert(raw_json != NULL);
+		return ljson::parser::try_parse_parallel(std::string_view(raw_json), threads);
 	}
 
-	bool node::is_double() const noexcept
+	ljson::node parser::parse_parallel(std::string_view raw_json, size_t threads)
 	{
-		return not this->is_value() ? false : this->as_value()->is_double();
+		expected<ljson::node, error> ok = ljson::parser::try_parse_parallel(raw_json, threads);
+		if (not ok)
+			throw ok.error();
+
+		return ok.value();
 	}
 
-	bool node::is_number() const noexcept
+	ljson::node parser::parse_parallel(const std::filesystem::path& path, size_t threads)
 	{
-		return not this->is_value() ? false : this->as_value()->is_number();
+		expected<ljson::node, error> ok = ljson::parser::try_parse_parallel(path, threads);
+		if (not ok)
+			throw ok.error();
+
+		return ok.value();
 	}
 
-	bool node::is_boolean() const noexcept
+	ljson::node parser::parse_parallel(const std::string& raw_json, size_t threads)
 	{
-		return not this->is_value() ? false : this->as_value()->is_boolean();
+		return ljson::parser::parse_parallel(std::string_view(raw_json), threads);
 	}
 
-	bool node::is_null() const noexcept
+	ljson::node parser::parse_parallel(const char* raw_json, size_t threads)
 	{
-		return not this->is_value() ? false : this->as_value()->is_null();
+		assert(raw_json != NULL);
+		return ljson::parser::parse_parallel(std::string_view(raw_json), threads);
 	}
 
-	node_type node::type() const noexcept
+	template<typename handler_type>
+	expected<monostate, error> parser::try_parse_events(std::string_view raw_json, handler_type& handler)
 	{
-		if (this->is_value())
-			return node_type::value;
-		else if (this->is_array())
-			return node_type::array;
-		else
-			return node_type::object;
+		// no structural index: the events are reported in one pass over the input and nothing is allocated
+		struct parsing_data data;
+		data.raw_json = raw_json;
+
+		return ljson::parser::parsing(data, handler);
 	}
 
-	std::string node::type_name() const noexcept
+	template<typename handler_type>
+	expected<monostate, error> parser::try_parse_events(const std::filesystem::path& path, handler_type& handler)
 	{
-		if (this->is_value())
-			return "node value";
-		else if (this->is_array())
-			return "node array";
-		else
-			return "node object";
+		file_buffer file;
+		if (auto ok = file.open(path); not ok)
+			return unexpected(ok.error());
+
+		return ljson::parser::try_parse_events(file.view(), handler);
 	}
 
-	template<is_allowed_value_type T>
-	expected<T, error> node::access_value(std::function<expected<T, error>(std::shared_ptr<class value>)> fun) const
+	template<typename handler_type>
+	expected<monostate, error> parser::try_parse_events(const std::string& raw_json, handler_type& handler)
 	{
-		auto val = this->try_as_value();
-		if (not val)
-		{
-			return val.error();
-		}
+		return ljson::parser::try_parse_events(std::string_view(raw_json), handler);
+	}
 
-		return fun(val.value());
+	template<typename handler_type>
+	expected<monostate, error> parser::try_parse_events(const char* raw_json, handler_type& handler)
+	{
+		return ljson::parser::try_parse_events(std::string_view(raw_json), handler);
 	}
 
-	expected<std::string, error> node::try_as_string() const noexcept
+	template<typename handler_type>
+	void parser::parse_events(std::string_view raw_json, handler_type& handler)
 	{
-		auto cast_fn = [](std::shared_ptr<class ljson::value> val) -> expected<std::string, error> { return val->try_as_string(); };
-		return this->access_value<std::string>(cast_fn);
+		auto ok = ljson::parser::try_parse_events(raw_json, handler);
+		if (not ok)
+			throw ok.error();
 	}
 
-	expected<int64_t, error> node::try_as_integer() const noexcept
+	expected<ljson::node, error> parser::try_parse(std::span<const std::byte> raw_json) noexcept
 	{
-		auto cast_func = [](std::shared_ptr<class ljson::value> val) -> expected<int64_t, error> { return val->try_as_integer(); };
-		return this->access_value<int64_t>(cast_func);
+		return ljson::parser::try_parse(std::string_view(reinterpret_cast<const char*>(raw_json.data()), raw_json.size()));
 	}
 
-	expected<double, error> node::try_as_double() const noexcept
+	expected<ljson::node, error> parser::try_parse(const std::filesystem::path& path) noexcept
 	{
-		auto cast_func = [](std::shared_ptr<class ljson::value> val) -> expected<double, error> { return val->try_as_double(); };
-		return this->access_value<double>(cast_func);
+		file_buffer file;
+		if (auto ok = file.open(path); not ok)
+			return unexpected(ok.error());
+
+		return ljson::parser::try_parse(file.view());
 	}
 
-	expected<double, error> node::try_as_number() const noexcept
+	expected<ljson::node, error> parser::try_parse(const std::string& raw_json) noexcept
 	{
-		auto cast_func = [](std::shared_ptr<class ljson::value> val) -> expected<double, error> { return val->try_as_number(); };
-		return this->access_value<double>(cast_func);
+		return ljson::parser::try_parse(std::string_view(raw_json));
 	}
 
-	expected<bool, error> node::try_as_boolean() const noexcept
+	expected<ljson::node, error> parser::try_parse(const char* raw_json) noexcept
 	{
-		auto cast_func = [](std::shared_ptr<class ljson::value> val) -> expected<bool, error> { return val->try_as_boolean(); };
-		return this->access_value<bool>(cast_func);
+		assert(raw_json != NULL);
+		return ljson::parser::try_parse(std::string_view(raw_json));
 	}
 
-	expected<null_type, error> node::try_as_null() const noexcept
+	parser::~parser()
 	{
-		auto cast_func = [](std::shared_ptr<class ljson::value> val) -> expected<null_type, error> { return val->try_as_null(); };
-		return this->access_value<null_type>(cast_func);
 	}
 
-	std::string node::as_string() const
+	expected<int64_t, error> token::try_as_integer() const noexcept
 	{
-		auto ok = this->try_as_string();
-		if (not ok)
-			throw ok.error();
-		return ok.value();
+		if (type != token_type::number)
+			return unexpected(error(error_type::wrong_type, "can't convert the token '{}' to an integer", text));
+
+		auto number = parser_syntax::literal::handle_number(text);
+		if (not number)
+			return unexpected(error(number.error(), "can't convert the token '{}' to an integer", text));
+		else if (not std::holds_alternative<int64_t>(number.value()))
+			return unexpected(error(error_type::wrong_type, "can't convert the token '{}' to an integer", text));
+
+		return std::get<int64_t>(number.value());
 	}
 
-	int64_t node::as_integer() const
+	expected<double, error> token::try_as_double() const noexcept
+	{
+		if (type != token_type::number)
+			return unexpected(error(error_type::wrong_type, "can't convert the token '{}' to a double", text));
+
+		auto number = parser_syntax::literal::handle_number(text);
+		if (not number)
+			return unexpected(error(number.error(), "can't convert the token '{}' to a double", text));
+		else if (const int64_t* integer = std::get_if<int64_t>(&number.value()))
+			return static_cast<double>(*integer);
+
+		return std::get<double>(number.value());
+	}
+
+	int64_t token::as_integer() const
 	{
 		auto ok = this->try_as_integer();
 		if (not ok)
 			throw ok.error();
+
 		return ok.value();
 	}
 
-	double node::as_double() const
+	double token::as_double() const
 	{
 		auto ok = this->try_as_double();
 		if (not ok)
 			throw ok.error();
+
 		return ok.value();
 	}
 
-	double node::as_number() const
+	reader::reader(std::string_view raw_json) : _data(std::make_unique<struct parsing_data>())
 	{
-		auto ok = this->try_as_number();
+		_data->raw_json = raw_json;
+	}
+
+	reader::reader(reader&& other) noexcept = default;
+
+	reader& reader::operator=(reader&& other) noexcept = default;
+
+	reader::~reader()
+	{
+	}
+
+	expected<ljson::token, error> reader::try_next() noexcept
+	{
+		ljson::token			  token;
+		parser_syntax::token_recorder recorder{*_data, token};
+
+		auto ok = ljson::parser::next_event(*_data, recorder);
 		if (not ok)
-			throw ok.error();
-		return ok.value();
+			return unexpected(ok.error());
+		else if (not ok.value() && _data->state != json_syntax::root && _data->state != json_syntax::done)
+			return unexpected(parser_syntax::syntax_error(*_data, _data->scopes.back() ? "']'" : "'}'"));
+		else if (not ok.value())
+			return ljson::token{token_type::end, {}};
+
+		return token;
 	}
 
-	bool node::as_boolean() const
+	ljson::token reader::next()
 	{
-		auto ok = this->try_as_boolean();
+		auto ok = this->try_next();
 		if (not ok)
 			throw ok.error();
+
 		return ok.value();
 	}
 
-	null_type node::as_null() const
+	expected<monostate, error> reader::try_skip() noexcept
 	{
-		auto ok = this->try_as_null();
+		// a closing bracket isn't a value, consuming it here would close a scope behind the caller's back
+		parser_syntax::skip_empty(*_data);
+		const json_syntax state = _data->state;
+		if (_data->i < _data->raw_json.size() && (_data->raw_json[_data->i] == '}' || _data->raw_json[_data->i] == ']') &&
+		    (state == json_syntax::key_or_end || state == json_syntax::value_or_end || state == json_syntax::end_statement))
+			return unexpected(error(error_type::wrong_type, "nothing to skip, the next token closes the {} at line: {}",
+			    _data->scopes.back() ? "array" : "object", parser_syntax::line_number(*_data)));
+
+		auto token = this->try_next();
+		if (not token)
+			return unexpected(token.error());
+		else if (token.value().type == token_type::key)
+			return this->try_skip();
+		else if (token.value().type != token_type::start_object && token.value().type != token_type::start_array)
+			return monostate();
+
+		struct parsing_data& data  = *_data;
+		std::string_view     raw   = data.raw_json;
+		size_t		     depth = 1;
+
+		for (; data.i < raw.size(); data.i++)
+		{
+			const char ch = raw[data.i];
+			if (ch == '"')
+			{
+				size_t begin = data.i;
+				while (true)
+				{
+					const void* quote = std::memchr(raw.data() + data.i + 1, '"', raw.size() - data.i - 1);
+					if (quote == nullptr)
+					{
+						data.i = begin;
+						return unexpected(parser_syntax::syntax_error(data, "a closing quote for the string"));
+					}
+
+					data.i = static_cast<const char*>(quote) - raw.data();
+
+					size_t backslashes = 0;
+					while (raw[data.i - 1 - backslashes] == '\\')
+						backslashes++;
+					if (backslashes % 2 == 0)
+						break;
+				}
+			}
+			else if (ch == '{' || ch == '[')
+				depth++;
+			else if ((ch == '}' || ch == ']') && --depth == 0)
+				break;
+		}
+
+		if (data.i >= raw.size())
+			return unexpected(parser_syntax::syntax_error(data, data.scopes.back() ? "']'" : "'}'"));
+		else if (raw[data.i] != (data.scopes.back() ? ']' : '}'))
+			return unexpected(parser_syntax::syntax_error(data, data.scopes.back() ? "']'" : "'}'"));
+
+		ljson::token			  closing;
+		parser_syntax::token_recorder recorder{data, closing};
+		return parser_syntax::closing_bracket::handle_closing_bracket(data, recorder);
+	}
+
+	void reader::skip()
+	{
+		auto ok = this->try_skip();
 		if (not ok)
 			throw ok.error();
-		return ok.value();
 	}
 
-	value_type node::valuetype() const noexcept
+	size_t reader::depth() const noexcept
 	{
-		if (not this->is_value())
-			return value_type::none;
-		return this->as_value()->type();
+		return _data->scopes.size();
 	}
 
-	std::string node::value_type_name() const noexcept
+	stream_parser::stream_parser(std::pmr::memory_resource* resource)
+	    : _state(std::make_unique<struct stream_state>(resource)), _resource(resource)
 	{
-		if (not this->is_value())
-			return "none";
-		return this->as_value()->type_name();
 	}
 
-	std::string node::stringify() const noexcept
+	stream_parser::stream_parser(stream_parser&& other) noexcept = default;
+
+	stream_parser& stream_parser::operator=(stream_parser&& other) noexcept = default;
+
+	stream_parser::~stream_parser()
 	{
-		if (this->is_value())
-			return this->as_value()->stringify();
-		else
-			return this->dump_to_string();
 	}
 
-	bool node::contains(const std::string& key) const noexcept
+	expected<monostate, error> stream_parser::try_feed(std::string_view chunk) noexcept
 	{
-		auto obj = this->try_as_object();
-		if (not obj)
-			return false;
-		auto itr = obj.value()->find(key);
+		struct stream_state& state = *_state;
+		if (state.failure.value() != error_type::none)
+			return unexpected(state.failure);
+
+		state.pending.append(chunk);
+
+		// a string that was left open by the last chunk is only scanned for its closing quote, so a long string
+		// is neither indexed nor parsed again for every chunk it spans
+		if (state.in_string && not state.close_string())
+			return monostate();
+
+		// everything up to the last bracket, comma or colon outside of a string can be parsed without cutting
+		// a string, number or literal in two
+		struct parsing_data& data	= state.data;
+		std::string_view     pending	= state.pending;
+		size_t		     safe	= 0;
+		size_t		     open_quote = pending.size();
+		if (pending.size() <= structural_index::max_size)
+		{
+			state.index.build(pending);
+			const std::vector<uint32_t>& positions = state.index.positions();
+			for (size_t i = positions.size(); i > 0 && safe == 0; i--)
+			{
+				const char ch = pending[positions[i - 1]];
+				if (std::string_view("{}[],:").find(ch) != std::string_view::npos)
+					safe = positions[i - 1] + 1;
+			}
+
+			// the quotes of a string are neighbouring positions, an odd run of quotes at the end leaves one open
+			size_t quotes = 0;
+			while (quotes < positions.size() && pending[positions[positions.size() - 1 - quotes]] == '"')
+				quotes++;
+			if (quotes % 2 == 1)
+				open_quote = positions.back();
 
-		if (itr != obj.value()->end())
-			return true;
+			data.index   = &state.index;
+			data.index_i = 0;
+		}
 		else
-			return false;
+		{
+			for (size_t i = 0; i < pending.size() && open_quote == pending.size(); i++)
+			{
+				const char ch = pending[i];
+				if (ch == '"')
+				{
+					state.scanned = i + 1;
+					state.escaped = false;
+					if (state.close_string())
+						i = state.scanned - 1;
+					else
+						open_quote = i;
+				}
+				else if (std::string_view("{}[],:").find(ch) != std::string_view::npos)
+					safe = i + 1;
+			}
+
+			data.index = nullptr;
+		}
+
+		if (open_quote != pending.size())
+		{
+			state.in_string = true;
+			state.escaped	= false;
+			state.scanned	= open_quote + 1;
+			state.close_string();
+		}
+
+		data.raw_json = pending.substr(0, safe);
+		while (true)
+		{
+			auto ok = ljson::parser::next_event(data, state.builder);
+			if (not ok)
+			{
+				state.failure = ok.error();
+				return unexpected(ok.error());
+			}
+			else if (not ok.value())
+				break;
+		}
+
+		// drop what was parsed, the line count of the dropped part is kept for error messages
+		size_t parsed = std::min(data.i, safe);
+		data.lines_before += std::count(state.pending.begin(), state.pending.begin() + parsed, '\n');
+		state.pending.erase(0, parsed);
+		state.scanned = state.in_string ? state.scanned - parsed : 0;
+		data.i	      = 0;
+		data.raw_json = {};
+		data.index    = nullptr;
+
+		return monostate();
 	}
 
-	class node& node::at(const std::string& object_key) const
+	expected<monostate, error> stream_parser::try_feed(std::span<const std::byte> chunk) noexcept
 	{
-		auto obj = this->as_object();
-		auto itr = obj->find(object_key);
-		if (itr == obj->end())
-			throw error(error_type::key_not_found, std::format("key: '{}' not found", object_key));
-		return itr->second;
+		return this->try_feed(std::string_view(reinterpret_cast<const char*>(chunk.data()), chunk.size()));
 	}
 
-	class node& node::at(const size_t array_index) const
+	void stream_parser::feed(std::string_view chunk)
 	{
-		auto arr = this->as_array();
-		if (array_index >= arr->size())
-			throw error(error_type::key_not_found, "index: '{}' not found", array_index);
+		auto ok = this->try_feed(chunk);
+		if (not ok)
+			throw ok.error();
+	}
 
-		return arr->at(array_index);
+	void stream_parser::feed(std::span<const std::byte> chunk)
+	{
+		auto ok = this->try_feed(chunk);
+		if (not ok)
+			throw ok.error();
 	}
 
-	expected<std::reference_wrapper<ljson::node>, ljson::error> node::try_at(const std::string& object_key) const noexcept
+	expected<ljson::node, error> stream_parser::try_finish() noexcept
 	{
-		auto obj = this->try_as_object();
-		if (not obj)
-			return unexpected(obj.error());
-		auto itr = obj.value()->find(object_key);
-		if (itr == obj.value()->end())
-			return unexpected(error(error_type::key_not_found, std::format("key: '{}' not found", object_key)));
+		std::unique_ptr<struct stream_state> state = std::exchange(_state, std::make_unique<struct stream_state>(_resource));
+		if (state->failure.value() != error_type::none)
+			return unexpected(state->failure);
 
-		return std::ref(itr->second);
+		struct parsing_data& data = state->data;
+		data.raw_json		  = state->pending;
+		if (data.raw_json.size() <= structural_index::max_size)
+		{
+			state->index.build(data.raw_json);
+			data.index   = &state->index;
+			data.index_i = 0;
+		}
+
+		auto ok = ljson::parser::parsing(data, state->builder);
+		if (not ok)
+			return unexpected(ok.error());
+
+		return state->root;
 	}
 
-	expected<std::reference_wrapper<ljson::node>, ljson::error> node::try_at(const size_t array_index) const noexcept
+	ljson::node stream_parser::finish()
 	{
-		auto arr = this->try_as_array();
-		if (not arr)
-			return unexpected(error(error_type::key_not_found, "index: '{}' not found", array_index));
+		auto ok = this->try_finish();
+		if (not ok)
+			throw ok.error();
 
-		return std::ref(arr.value()->at(array_index));
+		return ok.value();
 	}
 
-	template<typename container_or_node_type>
-	class node& node::operator=(const container_or_node_type& node_value) noexcept
+	expected<ljson::node, error> ndjson::parse_record(std::string_view record, size_t line) noexcept
 	{
-		if constexpr (std::is_same_v<container_or_node_type, ljson::node>)
+		struct parsing_data data;
+		data.raw_json	  = record;
+		data.lines_before = line;
+
+		return ljson::parser::parse_tree(data);
+	}
+
+	expected<monostate, error> ndjson::parse_chunk(
+	    std::string_view raw_json, std::string_view chunk, std::vector<ljson::node>& records) noexcept
+	{
+		for (iterator it(chunk); it != std::default_sentinel; ++it)
 		{
-			if (this != &node_value)
+			if (*it)
 			{
-				this->setting_allowed_node_type(node_value);
+				records.push_back(std::move(*it).value());
+				continue;
 			}
+
+			// the line numbers of a chunk start at 0, parse the record again to report its line in raw_json
+			size_t line = std::count(raw_json.data(), it.text().data(), '\n');
+			return unexpected(ndjson::parse_record(it.text(), line).error());
 		}
-		else
-		{
-			this->setting_allowed_node_type(node_value);
-		}
-		return *this;
+
+		return monostate();
 	}
 
-	class node& node::operator+=(const std::initializer_list<std::pair<std::string, std::any>>& pairs)
+	std::vector<std::string_view> ndjson::split(std::string_view raw_json, size_t count)
 	{
-		if (not this->is_object())
-			throw error(error_type::wrong_type, "wrong type: trying to insert pairs to a non-object");
-
-		std::string key;
-		auto	    map = this->as_object();
+		count = std::clamp<size_t>(raw_json.size() / min_chunk_size, 1, std::max<size_t>(count, 1));
 
-		auto insert_func = [&](const std::any& value)
+		std::vector<std::string_view> chunks;
+		size_t			      begin = 0;
+		for (size_t i = 1; i <= count && begin < raw_json.size(); i++)
 		{
-			if (value.type() == typeid(ljson::node))
-			{
-				auto val = std::any_cast<ljson::node>(value);
-				map->insert(key, val);
-			}
-			else
-			{
-				auto val = std::any_cast<class value>(value);
-				map->insert(key, ljson::node(val));
-			}
-		};
+			size_t end = i == count ? raw_json.size() : raw_json.find('\n', std::max(begin, raw_json.size() * i / count));
+			end	   = end == std::string_view::npos ? raw_json.size() : std::min(end + 1, raw_json.size());
 
-		for (const auto& pair : pairs)
-		{
-			key = pair.first;
-			this->handle_std_any(pair.second, insert_func);
-			key.clear();
+			chunks.push_back(raw_json.substr(begin, end - begin));
+			begin = end;
 		}
-		return *this;
+
+		return chunks;
 	}
 
-	class node& node::operator+=(const std::initializer_list<std::any>& val)
+	ndjson::iterator::iterator(std::string_view raw_json) : _rest(raw_json)
 	{
-		if (not this->is_array())
-			throw error(error_type::wrong_type, "wrong type: trying to insert pairs to a non-array");
-
-		auto vector = this->as_array();
-
-		auto insert_func = [&](const std::any& value)
-		{
-			if (value.type() == typeid(ljson::node))
-			{
-				auto val = std::any_cast<ljson::node>(value);
-				vector->push_back(val);
-			}
-			else
-			{
-				auto val = std::any_cast<class value>(value);
-				vector->push_back(ljson::node(val));
-			}
-		};
+		this->advance();
+	}
 
-		for (const auto& value : val)
+	void ndjson::iterator::advance()
+	{
+		while (not _rest.empty())
 		{
-			this->handle_std_any(value, insert_func);
+			size_t		 newline = _rest.find('\n');
+			std::string_view line	 = _rest.substr(0, newline);
+			_rest			 = newline == std::string_view::npos ? std::string_view() : _rest.substr(newline + 1);
+
+			size_t line_number = _next_line++;
+			if (line.find_first_not_of(" \t\r") == std::string_view::npos)
+				continue;
+
+			_text	= line;
+			_line	= line_number;
+			_record = ndjson::parse_record(line, line_number);
+			return;
 		}
+
+		_end = true;
+	}
+
+	const expected<ljson::node, error>& ndjson::iterator::operator*() const noexcept
+	{
+		return _record;
+	}
+
+	const expected<ljson::node, error>* ndjson::iterator::operator->() const noexcept
+	{
+		return &_record;
+	}
+
+	ndjson::iterator& ndjson::iterator::operator++()
+	{
+		this->advance();
 		return *this;
 	}
 
-	class node node::operator+(const node& other_node)
+	void ndjson::iterator::operator++(int)
 	{
-		if (this->type() != other_node.type())
-			throw error(error_type::wrong_type, "trying to + two nodes with different types");
+		this->advance();
+	}
 
-		if (this->is_object())
-		{
-			ljson::node new_node(ljson::node_type::object);
-			for (const auto& [key, node] : *this->as_object())
-			{
-				new_node.add_node_to_key(key, node);
-			}
-			for (const auto& [key, node] : *other_node.as_object())
-			{
-				new_node.add_node_to_key(key, node);
-			}
+	bool ndjson::iterator::operator==(std::default_sentinel_t) const noexcept
+	{
+		return _end;
+	}
 
-			return new_node;
-		}
-		else if (this->is_array())
-		{
-			ljson::node new_node(ljson::node_type::array);
-			for (const auto& node : *this->as_array())
-			{
-				new_node.add_node_to_array(node);
-			}
-			for (const auto& node : *other_node.as_array())
-			{
-				new_node.add_node_to_array(node);
-			}
+	size_t ndjson::iterator::line() const noexcept
+	{
+		return _line + 1;
+	}
 
-			return new_node;
-		}
-		else
-		{
-			ljson::node new_node(this->type());
-			auto	    val = this->as_value();
+	std::string_view ndjson::iterator::text() const noexcept
+	{
+		return _text;
+	}
 
-			if (val->type() == value_type::string)
-			{
-				new_node = this->as_value()->as_string() + other_node.as_value()->as_string();
-			}
-			else if (val->type() == value_type::double_t || val->type() == value_type::integer)
-			{
-				new_node = this->as_value()->as_number() + other_node.as_value()->as_number();
-			}
-			else
-			{
-				throw error(
-				    error_type::wrong_type, "trying to + two nodes with values that are neither a number nor string");
-			}
+	ndjson::ndjson(std::string_view raw_json) noexcept : _raw_json(raw_json)
+	{
+	}
+
+	ndjson::iterator ndjson::begin() const
+	{
+		return iterator(_raw_json);
+	}
+
+	std::default_sentinel_t ndjson::end() const noexcept
+	{
+		return std::default_sentinel;
+	}
 
-			return new_node;
-		}
+	expected<std::vector<ljson::node>, error> ndjson::try_parse(std::string_view raw_json, size_t threads)
+	{
+		std::vector<ljson::node> records;
+		auto ok = ljson::ndjson::try_for_each(raw_json, [&](ljson::node& record) { records.push_back(std::move(record)); },
+		    ndjson_order::ordered, threads);
+		if (not ok)
+			return unexpected(ok.error());
+
+		return records;
 	}
 
-	template<typename container_or_node_type>
-	void node::set(const container_or_node_type& node_value) noexcept
+	std::vector<ljson::node> ndjson::parse(std::string_view raw_json, size_t threads)
 	{
-		this->setting_allowed_node_type(node_value);
+		auto ok = ljson::ndjson::try_parse(raw_json, threads);
+		if (not ok)
+			throw ok.error();
+
+		return std::move(ok).value();
 	}
 
-	void node::dump(const std::function<void(std::string)> out_func, const std::pair<char, int>& indent_conf, int indent) const
+	template<typename callback_type>
+	expected<monostate, error> ndjson::try_for_each(std::string_view raw_json, callback_type&& callback, ndjson_order order, size_t threads)
 	{
-		using node_or_value = std::variant<std::shared_ptr<class value>, ljson::node>;
+		if (threads == 0)
+			threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
 
-		auto dump_val = [&indent, &out_func, &indent_conf](const node_or_value& value_or_nclass)
+		// a few chunks per thread so a slow chunk doesn't leave the other threads idle
+		std::vector<std::string_view> chunks = ljson::ndjson::split(raw_json, threads * 4);
+		if (threads == 1 || chunks.size() <= 1)
 		{
-			if (std::holds_alternative<std::shared_ptr<class value>>(value_or_nclass))
-			{
-				auto val = std::get<std::shared_ptr<class value>>(value_or_nclass);
-				assert(val != nullptr);
-				if (val->type() == ljson::value_type::string)
-					out_func(std::format("\"{}\"", val->stringify()));
-				else
-					out_func(std::format("{}", val->stringify()));
-			}
-			else
+			for (iterator it(raw_json); it != std::default_sentinel; ++it)
 			{
-				std::get<ljson::node>(value_or_nclass).dump(out_func, indent_conf, indent + indent_conf.second);
+				if (not *it)
+					return unexpected(it->error());
+
+				ljson::node record = it->value();
+				callback(record);
 			}
+
+			return monostate();
+		}
+
+		struct chunk_result {
+				std::vector<ljson::node>   records;
+				expected<monostate, error> status;
+				bool			   done = false;
 		};
 
-		if (this->is_object())
+		std::vector<chunk_result> results(chunks.size());
+		std::atomic<size_t>	  next_chunk   = 0;
+		std::atomic<size_t>	  failed_chunk = chunks.size();
+		std::mutex		  mutex;
+		std::condition_variable	  chunk_done;
+		std::exception_ptr	  thrown;
+
+		auto work = [&](std::stop_token stop)
 		{
-			out_func(std::format("{{\n"));
-			auto   map   = this->as_object();
-			size_t count = 0;
-			for (const auto& pair : *map)
+			for (size_t i = next_chunk++; i < chunks.size() && i < failed_chunk && not stop.stop_requested(); i = next_chunk++)
 			{
-				out_func(
-				    std::format("{}\"{}\": ", std::string(indent + indent_conf.second, indent_conf.first), pair.first));
-				dump_val(pair.second);
+				chunk_result& result = results[i];
+				result.status	     = ljson::ndjson::parse_chunk(raw_json, chunks[i], result.records);
+				if (not result.status)
+				{
+					size_t failed = failed_chunk;
+					while (i < failed && not failed_chunk.compare_exchange_weak(failed, i))
+						;
+				}
 
-				if (++count != map->size())
-					out_func(std::format(","));
+				std::lock_guard<std::mutex> lock(mutex);
+				if (order == ndjson_order::unordered && not thrown && i <= failed_chunk)
+				{
+					try
+					{
+						for (ljson::node& record : result.records)
+							callback(record);
+					}
+					catch (...)
+					{
+						thrown	     = std::current_exception();
+						failed_chunk = 0;
+					}
+					result.records.clear();
+				}
 
-				out_func(std::format("\n"));
+				result.done = true;
+				chunk_done.notify_all();
 			}
-			out_func(std::format("{}}}", std::string(indent, indent_conf.first)));
-		}
-		else if (this->is_array())
-		{
-			out_func(std::format("[\n"));
-			auto   vector = this->as_array();
-			size_t count  = 0;
-			for (const auto& array_value : *vector)
-			{
-				out_func(std::format("{}", std::string(indent + indent_conf.second, indent_conf.first)));
-				dump_val(array_value);
+		};
 
-				if (++count != vector->size())
-					out_func(std::format(","));
+		{
+			std::vector<std::jthread> workers;
+			for (size_t i = 0; i < std::min(threads, chunks.size()); i++)
+				workers.emplace_back(work);
 
-				out_func(std::format("\n"));
+			for (size_t i = 0; order == ndjson_order::ordered && i < chunks.size() && i <= failed_chunk; i++)
+			{
+				// a chunk after the failed one may never be parsed
+				std::unique_lock<std::mutex> lock(mutex);
+				chunk_done.wait(lock, [&]() { return results[i].done || i > failed_chunk; });
+				const bool done = results[i].done;
+				lock.unlock();
+				if (not done)
+					break;
+
+				// the workers are stopped by the std::jthread destructors if the callback throws
+				for (ljson::node& record : results[i].records)
+					callback(record);
+				results[i].records = {};
 			}
-			out_func(std::format("{}]", std::string(indent, indent_conf.first)));
+
+			for (std::jthread& worker : workers)
+				worker.join();
 		}
-		else if (this->is_value())
+
+		if (thrown)
+			std::rethrow_exception(thrown);
+
+		for (chunk_result& result : results)
 		{
-			auto val = this->as_value();
-			dump_val(val);
+			if (not result.status)
+				return unexpected(result.status.error());
 		}
+
+		return monostate();
 	}
 
-	void node::dump_to_stdout(const std::pair<char, int>& indent_conf) const
+	template<typename callback_type>
+	void ndjson::for_each(std::string_view raw_json, callback_type&& callback, ndjson_order order, size_t threads)
 	{
-		auto func = [](const std::string& output) { std::cout << output; };
-		this->dump(func, indent_conf);
+		auto ok = ljson::ndjson::try_for_each(raw_json, std::forward<callback_type>(callback), order, threads);
+		if (not ok)
+			throw ok.error();
 	}
 
-	std::string node::dump_to_string(const std::pair<char, int>& indent_conf) const
+	document::document(size_t initial_size, std::pmr::memory_resource* upstream)
+	    : _root(node_type::value), _arena(std::make_shared<std::pmr::monotonic_buffer_resource>(initial_size, upstream))
 	{
-		std::string data;
-		auto	    func = [&data](const std::string& output) { data += output; };
-		this->dump(func, indent_conf);
+		_root = ljson::node(node_type::object, _arena.get());
+	}
 
-		return data;
+	document::document(std::pmr::memory_resource* upstream)
+	    : _root(node_type::value), _arena(std::make_shared<std::pmr::monotonic_buffer_resource>(upstream))
+	{
+		_root = ljson::node(node_type::object, _arena.get());
 	}
 
-	expected<monostate, error> node::dump_to_file(const std::filesystem::path& path, const std::pair<char, int>& indent_conf) const
+	document::~document()
 	{
-		std::ofstream file(path);
-		if (not file.is_open())
-			return unexpected(error(error_type::filesystem_error, std::strerror(errno)));
+		// the tree has to be released while the arena is still alive
+		_root = ljson::node(node_type::value);
+	}
 
-		auto func = [&file](const std::string& output) { file << output; };
-		this->dump(func, indent_conf);
-		file.close();
+	ljson::document document::parse(const std::filesystem::path& path)
+	{
+		expected<ljson::document, error> ok = ljson::document::try_parse(path);
+		if (not ok)
+			throw ok.error();
 
-		return monostate();
+		return ok.value();
 	}
 
-	parser::parser()
+	ljson::document document::parse(const std::string& raw_json)
 	{
+		return ljson::document::parse(std::string_view(raw_json));
 	}
 
-	bool parser::done_or_not_ok(const expected<bool, error>& ok)
+	ljson::document document::parse(const char* raw_json)
 	{
-		if ((ok && ok.value()) || not ok)
-			return true;
-		else
-			return false;
+		assert(raw_json != NULL);
+		return ljson::document::parse(std::string_view(raw_json));
 	}
 
-	expected<monostate, error> parser::return_error_if_not_ok(const expected<bool, error>& ok)
+	ljson::document document::parse(std::string_view raw_json)
 	{
+		expected<ljson::document, error> ok = ljson::document::try_parse(raw_json);
 		if (not ok)
+			throw ok.error();
+
+		return ok.value();
+	}
+
+	expected<ljson::document, error> document::try_parse(const std::filesystem::path& path) noexcept
+	{
+		file_buffer file;
+		if (auto ok = file.open(path); not ok)
 			return unexpected(ok.error());
-		return monostate();
+
+		return ljson::document::try_parse(file.view());
 	}
 
-	expected<monostate, error> parser::check_unhandled_hierarchy(const std::string& raw_json, struct parsing_data& data)
+	expected<ljson::document, error> document::try_parse(const std::string& raw_json) noexcept
 	{
-		if (data.hierarchy.empty() || raw_json.empty())
-			return monostate();
+		return ljson::document::try_parse(std::string_view(raw_json));
+	}
+
+	expected<ljson::document, error> document::try_parse(const char* raw_json) noexcept
+	{
+		assert(raw_json != NULL);
+		return ljson::document::try_parse(std::string_view(raw_json));
+	}
+
+	expected<ljson::document, error> document::try_parse(std::string_view raw_json) noexcept
+	{
+		// the tree usually takes a few times the size of the text, start with one block of that size
+		ljson::document document(std::max<size_t>(raw_json.size(), 1024), std::pmr::get_default_resource());
+
+		auto ok = ljson::parser::try_parse(raw_json, document._arena.get());
+		if (not ok)
+			return unexpected(ok.error());
+
+		document._root = ok.value();
+		return document;
+	}
+
+	ljson::node& document::root() noexcept
+	{
+		return _root;
+	}
+
+	const ljson::node& document::root() const noexcept
+	{
+		return _root;
+	}
+
+	std::pmr::memory_resource* document::resource() const noexcept
+	{
+		return _arena.get();
+	}
+
+	file_buffer::~file_buffer()
+	{
+#if defined(__unix__) || defined(__APPLE__)
+		if (_mapped != nullptr)
+			::munmap(const_cast<char*>(_mapped), _size);
+#endif
+	}
+
+	expected<monostate, error> file_buffer::open(const std::filesystem::path& path)
+	{
+#if defined(__unix__) || defined(__APPLE__)
+		int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0)
+			return unexpected(ljson::error(
+			    error_type::filesystem_error, std::format("couldn't open '{}', {}", path.string(), std::strerror(errno))));
 
-		if (raw_json.back() == '}' && data.hierarchy.top().first == json_syntax::opening_bracket)
+		struct stat file_stat;
+		if (::fstat(fd, &file_stat) != 0)
 		{
-			data.line = "}";
-			data.i	  = 0;
-			assert(data.i < data.line.size());
-			if (auto ok = parser_syntax::closing_bracket::handle_closing_bracket(data); done_or_not_ok(ok))
-			{
-				return return_error_if_not_ok(ok);
-			}
+			int err = errno;
+			::close(fd);
+			return unexpected(ljson::error(
+			    error_type::filesystem_error, std::format("couldn't stat '{}', {}", path.string(), std::strerror(err))));
 		}
-		else
+
+		if (S_ISREG(file_stat.st_mode) && file_stat.st_size > 0)
 		{
-			data.line = (not raw_json.empty()) ? std::string(raw_json.back(), 1) : "";
-			data.i	  = std::min(raw_json.size() - 1, ( size_t ) 0);
-			assert(data.i < data.line.size());
-			if (auto ok = parser_syntax::syntax_error::handle_syntax_error(data); done_or_not_ok(ok))
+			size_t size    = static_cast<size_t>(file_stat.st_size);
+			void*  address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (address != MAP_FAILED)
 			{
-				return return_error_if_not_ok(ok);
+				::madvise(address, size, MADV_SEQUENTIAL);
+				::close(fd);
+				_mapped = static_cast<const char*>(address);
+				_size	= size;
+				return monostate();
 			}
 		}
 
+		size_t size_hint = S_ISREG(file_stat.st_mode) ? static_cast<size_t>(file_stat.st_size) : 0;
+		auto   ok	 = this->read_fd(fd, size_hint);
+		::close(fd);
+		if (not ok)
+			return unexpected(ljson::error(error_type::filesystem_error,
+			    std::format("couldn't read '{}', {}", path.string(), ok.error().message())));
+
+		return monostate();
+#else
+		std::ifstream file(path, std::ios::binary);
+		if (not file.is_open())
+			return unexpected(ljson::error(
+			    error_type::filesystem_error, std::format("couldn't open '{}', {}", path.string(), std::strerror(errno))));
+
+		_buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		if (file.bad())
+			return unexpected(ljson::error(
+			    error_type::filesystem_error, std::format("couldn't read '{}', {}", path.string(), std::strerror(errno))));
+
+		_size = _buffer.size();
 		return monostate();
+#endif
 	}
 
-	expected<monostate, error> parser::parsing(struct parsing_data& data)
+#if defined(__unix__) || defined(__APPLE__)
+	expected<monostate, error> file_buffer::read_fd(int fd, size_t size_hint)
 	{
-		expected<bool, error> ok;
-
-		if (parser_syntax::end_statement::run_till_end_of_statement(data))
-			return monostate();
+		const size_t chunk_size = 64 * 1024;
+		_buffer.resize(std::max(size_hint, chunk_size));
 
-		if (ok = parser_syntax::empty::handle_empty(data); done_or_not_ok(ok))
-		{
-			return return_error_if_not_ok(ok);
-		}
-		else if (ok = parser_syntax::quotes::handle_quotes(data); done_or_not_ok(ok))
-		{
-			return return_error_if_not_ok(ok);
-		}
-		else if (ok = parser_syntax::key::handle_key(data); done_or_not_ok(ok))
-		{
-			return return_error_if_not_ok(ok);
-		}
-		else if (ok = parser_syntax::column::handle_column(data); done_or_not_ok(ok))
-		{
-			return return_error_if_not_ok(ok);
-		}
-		else if (ok = parser_syntax::value::handle_value(data); done_or_not_ok(ok))
-		{
-			return return_error_if_not_ok(ok);
-		}
-		else if (ok = parser_syntax::object::handle_object(data); done_or_not_ok(ok))
-		{
-			return return_error_if_not_ok(ok);
-		}
-		else if (ok = parser_syntax::array::handle_array(data); done_or_not_ok(ok))
-		{
-			return return_error_if_not_ok(ok);
-		}
-		else if (ok = parser_syntax::end_statement::handle_end_statement(data); done_or_not_ok(ok))
-		{
-			return return_error_if_not_ok(ok);
-		}
-		else if (ok = parser_syntax::open_bracket::handle_open_bracket(data); done_or_not_ok(ok))
-		{
-			return return_error_if_not_ok(ok);
-		}
-		else if (ok = parser_syntax::closing_bracket::handle_closing_bracket(data); done_or_not_ok(ok))
-		{
-			return return_error_if_not_ok(ok);
-		}
-		else if (ok = parser_syntax::syntax_error::handle_syntax_error(data); done_or_not_ok(ok))
+		size_t used = 0;
+		while (true)
 		{
-			return return_error_if_not_ok(ok);
+			if (used == _buffer.size())
+				_buffer.resize(_buffer.size() * 2);
+
+			ssize_t count = ::read(fd, _buffer.data() + used, _buffer.size() - used);
+			if (count < 0 && errno == EINTR)
+				continue;
+			else if (count < 0)
+				return unexpected(error(error_type::filesystem_error, std::strerror(errno)));
+			else if (count == 0)
+				break;
+
+			used += static_cast<size_t>(count);
 		}
 
+		_buffer.resize(used);
+		_size = used;
 		return monostate();
 	}
+#endif
 
-	ljson::node parser::parse(const std::filesystem::path& path)
+	std::string_view file_buffer::view() const noexcept
 	{
-		expected<ljson::node, error> ok = ljson::parser::try_parse(path);
-		if (not ok)
-			throw ok.error();
+		if (_mapped != nullptr)
+			return std::string_view(_mapped, _size);
+		return std::string_view(_buffer.data(), _size);
+	}
 
-		return ok.value();
+	bool file_buffer::is_mapped() const noexcept
+	{
+		return _mapped != nullptr;
 	}
 
-	ljson::node parser::parse(const char* raw_json)
+	structural_index::block_masks structural_index::classify_scalar(const char* block) noexcept
 	{
-		expected<ljson::node, error> ok = ljson::parser::try_parse(raw_json);
-		if (not ok)
-			throw ok.error();
+		block_masks masks;
+		for (size_t i = 0; i < 64; i++)
+		{
+			const uint64_t bit = uint64_t(1) << i;
+			switch (block[i])
+			{
+				case '"':
+					masks.quote |= bit;
+					break;
+				case '\\':
+					masks.backslash |= bit;
+					break;
+				case '{':
+				case '}':
+				case '[':
+				case ']':
+				case ':':
+				case ',':
+					masks.structural |= bit;
+					break;
+				case ' ':
+				case '\t':
+				case '\n':
+				case '\r':
+					masks.empty |= bit;
+					break;
+				default:
+					break;
+			}
+		}
 
-		return ok.value();
+		return masks;
 	}
 
-	ljson::node parser::parse(const std::string& raw_json)
+#if defined(LJSON_X86_64)
+	structural_index::block_masks structural_index::classify_sse2(const char* block) noexcept
 	{
-		expected<ljson::node, error> ok = ljson::parser::try_parse(raw_json);
-		if (not ok)
-			throw ok.error();
+		block_masks masks;
+		for (int i = 0; i < 4; i++)
+		{
+			__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i * 16));
+			// '[' and ']' only differ from '{' and '}' by 0x20
+			__m128i lower = _mm_or_si128(chunk, _mm_set1_epi8(0x20));
+
+			auto bits = [&](__m128i matches) -> uint64_t
+			{ return static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(matches))) << (i * 16); };
+
+			masks.quote |= bits(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('"')));
+			masks.backslash |= bits(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\\')));
+			masks.structural |= bits(_mm_or_si128(
+			    _mm_or_si128(_mm_cmpeq_epi8(lower, _mm_set1_epi8('{')), _mm_cmpeq_epi8(lower, _mm_set1_epi8('}'))),
+			    _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(':')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8(',')))));
+			masks.empty |= bits(_mm_or_si128(
+			    _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\t'))),
+			    _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\r')))));
+		}
 
-		return ok.value();
+		return masks;
 	}
 
-	expected<ljson::node, error> parser::try_parse(const std::filesystem::path& path) noexcept
+	LJSON_TARGET_AVX2 structural_index::block_masks structural_index::classify_avx2(const char* block) noexcept
 	{
-		ljson::node json_data = ljson::node(node_type::object);
+		block_masks masks;
+		for (int i = 0; i < 2; i++)
+		{
+			__m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + i * 32));
+			// '[' and ']' only differ from '{' and '}' by 0x20
+			__m256i lower = _mm256_or_si256(chunk, _mm256_set1_epi8(0x20));
+
+			auto bits = [&](__m256i matches) LJSON_TARGET_AVX2 -> uint64_t
+			{ return static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(matches))) << (i * 32); };
+
+			masks.quote |= bits(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('"')));
+			masks.backslash |= bits(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\\')));
+			masks.structural |= bits(_mm256_or_si256(
+			    _mm256_or_si256(_mm256_cmpeq_epi8(lower, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(lower, _mm256_set1_epi8('}'))),
+			    _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(':')), _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(',')))));
+			masks.empty |= bits(_mm256_or_si256(
+			    _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\t'))),
+			    _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\r')))));
+		}
 
-		std::unique_ptr<std::ifstream> file = std::make_unique<std::ifstream>(path);
-		if (not file->is_open())
-			return unexpected(ljson::error(
-			    error_type::filesystem_error, std::format("couldn't open '{}', {}", path.string(), std::strerror(errno))));
-		struct parsing_data data;
+		return masks;
+	}
+#elif defined(LJSON_ARM64)
+	structural_index::block_masks structural_index::classify_neon(const char* block) noexcept
+	{
+		uint8x16_t chunks[4];
+		for (int i = 0; i < 4; i++)
+			chunks[i] = vld1q_u8(reinterpret_cast<const uint8_t*>(block + i * 16));
+
+		// neon has no movemask, every lane keeps its own bit and the lanes are summed pairwise
+		static const uint8_t bit_values[16] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
+		const uint8x16_t     bit_mask	    = vld1q_u8(bit_values);
+		auto		     bits	    = [&](auto matches) -> uint64_t
+		{
+			uint8x16_t sum0 = vpaddq_u8(vandq_u8(matches(chunks[0]), bit_mask), vandq_u8(matches(chunks[1]), bit_mask));
+			uint8x16_t sum1 = vpaddq_u8(vandq_u8(matches(chunks[2]), bit_mask), vandq_u8(matches(chunks[3]), bit_mask));
+			sum0		= vpaddq_u8(sum0, sum1);
+			sum0		= vpaddq_u8(sum0, sum0);
+			return vgetq_lane_u64(vreinterpretq_u64_u8(sum0), 0);
+		};
+
+		block_masks masks;
+		masks.quote	 = bits([](uint8x16_t chunk) { return vceqq_u8(chunk, vdupq_n_u8('"')); });
+		masks.backslash	 = bits([](uint8x16_t chunk) { return vceqq_u8(chunk, vdupq_n_u8('\\')); });
+		masks.structural = bits(
+		    [](uint8x16_t chunk)
+		    {
+			    // '[' and ']' only differ from '{' and '}' by 0x20
+			    uint8x16_t lower = vorrq_u8(chunk, vdupq_n_u8(0x20));
+			    return vorrq_u8(vorrq_u8(vceqq_u8(lower, vdupq_n_u8('{')), vceqq_u8(lower, vdupq_n_u8('}'))),
+				vorrq_u8(vceqq_u8(chunk, vdupq_n_u8(':')), vceqq_u8(chunk, vdupq_n_u8(','))));
+		    });
+		masks.empty = bits(
+		    [](uint8x16_t chunk)
+		    {
+			    return vorrq_u8(vorrq_u8(vceqq_u8(chunk, vdupq_n_u8(' ')), vceqq_u8(chunk, vdupq_n_u8('\t'))),
+				vorrq_u8(vceqq_u8(chunk, vdupq_n_u8('\n')), vceqq_u8(chunk, vdupq_n_u8('\r'))));
+		    });
+
+		return masks;
+	}
+#endif
+
+	uint64_t structural_index::escaped_chars(uint64_t backslash, uint64_t& prev_escaped) noexcept
+	{
+		// a backslash escaped by the previous block doesn't start an escape
+		backslash &= ~prev_escaped;
+		uint64_t follows_escape = backslash << 1 | prev_escaped;
+
+		// runs of backslashes that start on an odd bit are moved to start on an even bit by adding the
+		// start of the run, the carry tells if the last run continues into the next block
+		const uint64_t even_bits	   = 0x5555555555555555ULL;
+		uint64_t       odd_sequence_starts = backslash & ~even_bits & ~follows_escape;
+		uint64_t       sequences_starting_on_even_bits = odd_sequence_starts + backslash;
+		prev_escaped				       = sequences_starting_on_even_bits < backslash ? 1 : 0;
+		uint64_t invert_mask			       = sequences_starting_on_even_bits << 1;
+
+		return (even_bits ^ invert_mask) & follows_escape;
+	}
 
-		data.json_objs.push(json_data);
-		data.keys.push({"", key_type::simple_key});
+	uint64_t structural_index::prefix_xor(uint64_t bits) noexcept
+	{
+		bits ^= bits << 1;
+		bits ^= bits << 2;
+		bits ^= bits << 4;
+		bits ^= bits << 8;
+		bits ^= bits << 16;
+		bits ^= bits << 32;
+		return bits;
+	}
+
+	template<structural_index::block_masks (*classify)(const char*) noexcept>
+	void structural_index::scan(std::string_view raw_json)
+	{
+		_positions.clear();
+		_positions.reserve(raw_json.size() / 8);
 
-		expected<monostate, error> ok;
+		uint64_t prev_escaped	= 0;
+		uint64_t prev_in_string = 0;
+		uint64_t prev_scalar	= 0;
 
-		while (std::getline(*file, data.line))
+		for (size_t offset = 0; offset < raw_json.size(); offset += 64)
 		{
-			data.line += "\n";
-			for (data.i = 0; data.i < data.line.size(); data.i++)
+			block_masks masks;
+			uint64_t    valid = ~uint64_t(0);
+			if (raw_json.size() - offset >= 64)
 			{
-				ok = ljson::parser::parsing(data);
-				if (not ok)
-					return unexpected(ok.error());
+				masks = classify(raw_json.data() + offset);
+			}
+			else
+			{
+				char tail[64];
+				std::memset(tail, ' ', sizeof(tail));
+				std::memcpy(tail, raw_json.data() + offset, raw_json.size() - offset);
+				masks = classify(tail);
+				valid = (uint64_t(1) << (raw_json.size() - offset)) - 1;
 			}
 
-			if (not file->eof())
-				data.line.clear();
+			uint64_t quote	   = masks.quote & ~escaped_chars(masks.backslash, prev_escaped);
+			uint64_t in_string = prefix_xor(quote) ^ prev_in_string;
+			prev_in_string	   = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
 
-			data.line_number++;
-		}
+			uint64_t scalar	      = ~(masks.structural | masks.empty | masks.quote | in_string);
+			uint64_t scalar_start = scalar & ~(scalar << 1 | prev_scalar);
+			prev_scalar	      = scalar >> 63;
 
-		ok = ljson::parser::check_unhandled_hierarchy(data.line, data);
-		if (not ok)
-			return unexpected(ok.error());
+			uint64_t tokens = ((masks.structural & ~in_string) | quote | scalar_start) & valid;
 
-		return json_data;
+			size_t count = _positions.size();
+			_positions.resize(count + static_cast<size_t>(std::popcount(tokens)));
+			for (; tokens != 0; tokens &= tokens - 1)
+				_positions[count++] = static_cast<uint32_t>(offset + static_cast<size_t>(std::countr_zero(tokens)));
+		}
 	}
 
-	expected<ljson::node, error> parser::try_parse(const std::string& raw_json) noexcept
+	simd_type structural_index::best_simd_type() noexcept
 	{
-		ljson::node json_data = ljson::node(node_type::object);
+		static const simd_type best = []()
+		{
+#if defined(LJSON_X86_64)
+#	if defined(_MSC_VER) && not defined(__clang__)
+			int info[4];
+			__cpuid(info, 1);
+			bool os_avx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6;
+			__cpuidex(info, 7, 0);
+			if (os_avx && (info[1] & (1 << 5)))
+				return simd_type::avx2;
+#	else
+			if (__builtin_cpu_supports("avx2"))
+				return simd_type::avx2;
+#	endif
+			return simd_type::sse2;
+#elif defined(LJSON_ARM64)
+			return simd_type::neon;
+#else
+			return simd_type::scalar;
+#endif
+		}();
+
+		return best;
+	}
 
-		struct parsing_data data;
+	bool structural_index::is_supported(simd_type type) noexcept
+	{
+		switch (type)
+		{
+			case simd_type::scalar:
+				return true;
+			case simd_type::sse2:
+				return best_simd_type() == simd_type::sse2 || best_simd_type() == simd_type::avx2;
+			case simd_type::avx2:
+			case simd_type::neon:
+				return best_simd_type() == type;
+		}
 
-		data.json_objs.push(json_data);
-		data.keys.push({"", key_type::simple_key});
+		return false;
+	}
 
-		expected<monostate, error> ok;
+	void structural_index::build(std::string_view raw_json, simd_type type)
+	{
+		assert(raw_json.size() <= max_size);
+		if (not is_supported(type))
+			type = simd_type::scalar;
 
-		for (size_t i = 0; i < raw_json.size(); i++)
+		switch (type)
 		{
-			data.line += raw_json[i];
+#if defined(LJSON_X86_64)
+			case simd_type::avx2:
+				return this->scan<classify_avx2>(raw_json);
+			case simd_type::sse2:
+				return this->scan<classify_sse2>(raw_json);
+			case simd_type::neon:
+				break;
+#elif defined(LJSON_ARM64)
+			case simd_type::neon:
+				return this->scan<classify_neon>(raw_json);
+			case simd_type::avx2:
+			case simd_type::sse2:
+				break;
+#else
+			case simd_type::avx2:
+			case simd_type::sse2:
+			case simd_type::neon:
+				break;
+#endif
+			case simd_type::scalar:
+				break;
+		}
 
-			if (not data.line.empty() && (data.line.back() == '\n' || data.line.back() == ',' || data.line.back() == '}'))
-			{
+		this->scan<classify_scalar>(raw_json);
+	}
 
-				for (data.i = 0; data.i < data.line.size(); data.i++)
-				{
-					ok = ljson::parser::parsing(data);
-					if (not ok)
-						return unexpected(ok.error());
-				}
-				data.line.clear();
+	const std::vector<uint32_t>& structural_index::positions() const noexcept
+	{
+		return _positions;
+	}
 
-				data.line_number++;
-			}
-		}
+	error::error(error_type err, const std::string& message) noexcept : err_type(err), msg(message)
+	{
+	}
 
-		ok = ljson::parser::check_unhandled_hierarchy(raw_json, data);
-		if (not ok)
-			return unexpected(ok.error());
+	template<typename... args_t>
+	error::error(error_type err, std::format_string<args_t...> fmt, args_t&&... args) noexcept
+	    : err_type(err), msg(std::format(fmt, std::forward<args_t>(args)...))
+	{
+	}
 
-		return json_data;
+	error::error(error_type err, lazy_message message) noexcept : err_type(err), lazy(message)
+	{
 	}
 
-	expected<ljson::node, error> parser::try_parse(const char* raw_json) noexcept
+	error::error(const error& other) : err_type(other.err_type), msg(other.msg), lazy(other.lazy)
 	{
-		assert(raw_json != NULL);
-		std::string string_json(raw_json);
-		return ljson::parser::try_parse(string_json);
 	}
 
-	parser::~parser()
+	error::error(error&& other) noexcept
+	    : err_type(other.err_type), msg(std::move(other.msg)), lazy(other.lazy), formatted(other.formatted.exchange(nullptr))
 	{
 	}
 
-	error::error(error_type err, const std::string& message) noexcept : err_type(err), msg(message)
+	error& error::operator=(const error& other)
+	{
+		if (this != &other)
+			*this = error(other);
+
+		return *this;
+	}
+
+	error& error::operator=(error&& other) noexcept
 	{
+		if (this != &other)
+		{
+			err_type = other.err_type;
+			msg	 = std::move(other.msg);
+			lazy	 = other.lazy;
+			delete formatted.exchange(other.formatted.exchange(nullptr));
+		}
+
+		return *this;
 	}
 
-	template<typename... args_t>
-	error::error(error_type err, std::format_string<args_t...> fmt, args_t&&... args) noexcept
-	    : err_type(err), msg(std::format(fmt, std::forward<args_t>(args)...))
+	error::~error()
 	{
+		delete formatted.load();
 	}
 
 	const char* error::what() const noexcept
 	{
-		return msg.c_str();
+		return this->message().c_str();
 	}
 
 	const std::string& error::message() const noexcept
 	{
-		return msg;
+		if (lazy.fmt == nullptr)
+			return msg;
+		else if (const std::string* done = formatted.load(std::memory_order_acquire))
+			return *done;
+
+		// the error can be shared between threads (ndjson and parallel results), so the message is formatted
+		// into its own buffer and published once. a thread that loses the race drops its copy
+		try
+		{
+			auto	     text     = std::make_unique<std::string>(std::vformat(lazy.fmt, std::make_format_args(lazy.first, lazy.second)));
+			std::string* existing = nullptr;
+			if (formatted.compare_exchange_strong(existing, text.get(), std::memory_order_acq_rel, std::memory_order_acquire))
+				return *text.release();
+
+			return *existing;
+		}
+		catch (...)
+		{
+			// out of memory while formatting, msg is empty for a lazy message
+			return msg;
+		}
 	}
 
 	error_type error::value() const noexcept
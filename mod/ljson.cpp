@@ -19,11 +19,24 @@ export namespace ljson {
 	using ljson::null_type;
 	using ljson::null;
 	using ljson::object;
+	using ljson::ordered_map;
 	using ljson::parser;
+	using ljson::sax_handler;
+	using ljson::reader;
+	using ljson::token;
+	using ljson::token_type;
+	using ljson::stream_parser;
+	using ljson::ndjson;
+	using ljson::ndjson_order;
+	using ljson::document;
+	using ljson::dump_style;
+	using ljson::structural_index;
+	using ljson::simd_type;
 	using ljson::value;
 	using ljson::value_type;
 	using ljson::object_pairs;
 	using ljson::array_values;
+	using ljson::node_initializer;
 	using ljson::expected;
 	using ljson::unexpected;
 	using ljson::monostate;
@@ -0,0 +1,182 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <ljson.hpp>
+
+template<typename... args_t>
+void println(std::format_string<args_t...> fmt, args_t&&... args)
+{
+	std::string output = std::format(fmt, std::forward<args_t>(args)...);
+	std::cout << output << "\n";
+}
+
+ljson::node make_document(size_t records)
+{
+	ljson::node root;
+	ljson::node array(ljson::node_type::array);
+
+	for (size_t i = 0; i < records; i++)
+	{
+		// clang-format off
+		ljson::node record = {
+			{"id", static_cast<int>(i)},
+			{"name", "record name"},
+			{"score", 12.5},
+			{"active", i % 2 == 0},
+			{"parent", ljson::null},
+			{"tags", ljson::node({"tag1", "tag2", "tag3"})},
+		};
+		// clang-format on
+		array.push_back(record);
+	}
+
+	root.insert("records", array);
+	return root;
+}
+
+template<typename function_type>
+double seconds(function_type function, int iterations)
+{
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; i++)
+		function();
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	return elapsed.count() / iterations;
+}
+
+void report(const std::string& name, size_t bytes, double seconds)
+{
+	println("{:<24} {:>10.2f} MB/s {:>10.3f} ms", name, bytes / seconds / 1e6, seconds * 1e3);
+}
+
+int main(int argc, char** argv)
+{
+	size_t records	  = argc > 1 ? std::stoul(argv[1]) : 20000;
+	int    iterations = argc > 2 ? std::stoi(argv[2]) : 5;
+
+	std::string raw_json = make_document(records).dump_to_string();
+	println("document: {} records, {} bytes", records, raw_json.size());
+
+	auto ok = ljson::parser::try_parse(raw_json);
+	if (not ok)
+	{
+		println("parsing failed: {}", ok.error().message());
+		return 1;
+	}
+
+	report("build (initializer lists)", raw_json.size(), seconds([&]() { make_document(records); }, iterations));
+	report("parse(std::string)", raw_json.size(), seconds([&]() { ljson::parser::try_parse(raw_json); }, iterations));
+	report("parse_parallel", raw_json.size(), seconds([&]() { ljson::parser::try_parse_parallel(raw_json); }, iterations));
+	report("validate", raw_json.size(), seconds([&]() { ljson::parser::validate(raw_json); }, iterations));
+
+	// the same document without indentation, the parse/validate ratio is bound by the tokens instead of the whitespace
+	std::string compact = ok.value().dump_to_string(ljson::dump_style::compact);
+	report("parse (compact)", compact.size(), seconds([&]() { ljson::parser::try_parse(compact); }, iterations));
+	report("validate (compact)", compact.size(), seconds([&]() { ljson::parser::validate(compact); }, iterations));
+
+	report("parse_events (sax)", raw_json.size(),
+	    seconds(
+		[&]()
+		{
+			struct sum_handler : ljson::sax_handler {
+					int64_t sum = 0;
+
+					bool on_integer(int64_t number)
+					{
+						sum += number;
+						return true;
+					}
+			} handler;
+			ljson::parser::try_parse_events(raw_json, handler);
+			return handler.sum;
+		},
+		iterations));
+	report("reader (ids, skip rest)", raw_json.size(),
+	    seconds(
+		[&]()
+		{
+			int64_t	      sum = 0;
+			ljson::reader reader(raw_json);
+			for (ljson::token token = reader.next(); token.type != ljson::token_type::end; token = reader.next())
+			{
+				if (token.type == ljson::token_type::key && token.text == "id")
+					sum += reader.next().as_integer();
+				else if (token.type == ljson::token_type::key && token.text != "records")
+					reader.skip();
+			}
+			return sum;
+		},
+		iterations));
+	report("stream_parser (64 KB)", raw_json.size(),
+	    seconds(
+		[&]()
+		{
+			ljson::stream_parser parser;
+			for (size_t i = 0; i < raw_json.size(); i += 64 * 1024)
+				parser.feed(std::string_view(raw_json).substr(i, 64 * 1024));
+			return parser.finish();
+		},
+		iterations));
+
+	// a single string over many chunks, every chunk only scans its own bytes
+	std::string long_string = "{\"s\": \"" + std::string(32 * 1024 * 1024, 'x') + "\"}";
+	report("stream_parser (string)", long_string.size(),
+	    seconds(
+		[&]()
+		{
+			ljson::stream_parser parser;
+			for (size_t i = 0; i < long_string.size(); i += 64 * 1024)
+				parser.feed(std::string_view(long_string).substr(i, 64 * 1024));
+			return parser.finish();
+		},
+		iterations));
+	report("document::parse (arena)", raw_json.size(), seconds([&]() { ljson::document::try_parse(raw_json); }, iterations));
+
+	std::string ndjson;
+	for (const ljson::node& record : ok.value().at("records").as_array_ref())
+		ndjson += record.dump_to_string(ljson::dump_style::compact) + "\n";
+	report("ndjson (1 thread)", ndjson.size(), seconds([&]() { ljson::ndjson::try_parse(ndjson, 1); }, iterations));
+	report("ndjson (all threads)", ndjson.size(), seconds([&]() { ljson::ndjson::try_parse(ndjson); }, iterations));
+
+	for (auto [type, name] : {std::pair{ljson::simd_type::scalar, "index (scalar)"}, std::pair{ljson::simd_type::sse2, "index (sse2)"},
+		 std::pair{ljson::simd_type::avx2, "index (avx2)"}, std::pair{ljson::simd_type::neon, "index (neon)"}})
+	{
+		if (not ljson::structural_index::is_supported(type))
+			continue;
+
+		ljson::structural_index index;
+		report(name, raw_json.size(), seconds([&]() { index.build(raw_json, type); }, iterations));
+	}
+
+	ljson::node document = ok.value();
+	report("read fields (get<T>)", raw_json.size(),
+	    seconds(
+		[&]()
+		{
+			int64_t sum = 0;
+			for (const ljson::node& record : document.at("records").as_array_ref())
+				sum += record.at("id").get<int64_t>() + static_cast<int64_t>(record.at("name").get<std::string_view>().size());
+			return sum;
+		},
+		iterations));
+	report("dump_to_string", raw_json.size(), seconds([&]() { document.dump_to_string(); }, iterations));
+	report("dump_to_string(compact)", document.dump_to_string(ljson::dump_style::compact).size(),
+	    seconds([&]() { document.dump_to_string(ljson::dump_style::compact); }, iterations));
+
+	std::filesystem::path path = std::filesystem::temp_directory_path() / "ljson_bench.json";
+	std::ofstream(path) << raw_json;
+	report("parse(path)", raw_json.size(), seconds([&]() { ljson::parser::try_parse(path); }, iterations));
+	report("ifstream + parse(string)", raw_json.size(),
+	    seconds(
+		[&]()
+		{
+			std::ifstream file(path, std::ios::binary);
+			std::string   content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+			ljson::parser::try_parse(content);
+		},
+		iterations));
+	std::filesystem::remove(path);
+}
@@ -2,8 +2,13 @@
 #include <initializer_list>
 #include <iostream>
 #include <list>
+#include <map>
 #include <string>
 #include <array>
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <ljson.hpp>
 #include <gtest/gtest.h>
 
@@ -19,6 +24,28 @@ void println()
 	std::cout << "\n";
 }
 
+// counts every call of the global operator new, for the tests that check a path doesn't allocate
+static std::atomic<size_t> global_allocations = 0;
+
+void* operator new(size_t size)
+{
+	global_allocations++;
+	if (void* p = std::malloc(size == 0 ? 1 : size))
+		return p;
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+	std::free(p);
+}
+
 class ljson_test : public ::testing::Test {
 	protected:
 		void SetUp() override
@@ -193,6 +220,13 @@ TEST_F(ljson_test, construct_from_initializer_list)
 	EXPECT_TRUE(node.at("key1").as_value()->is_integer());
 	EXPECT_EQ(node.at("key1").as_value()->as_integer(), 5);
 
+	// values live inside the node, as_value() hands out a copy that can't be changed
+	static_assert(std::is_const_v<std::remove_reference_t<decltype(*node.as_value())>>);
+	static_assert(std::is_const_v<std::remove_reference_t<decltype(*node.try_as_value().value())>>);
+	node.at("key1").set(6);
+	EXPECT_EQ(node.at("key1").as_value()->as_integer(), 6);
+	node.at("key1").set(5);
+
 	EXPECT_TRUE(node.at("key2").is_value());
 	EXPECT_TRUE(node.at("key2").as_value()->is_string());
 	EXPECT_EQ(node.at("key2").as_value()->as_string(), "value");
@@ -317,24 +351,992 @@ TEST_F(ljson_test, invalid_json)
 
 #if defined(_WIN32) || defined(_WIN64)
 #else
-	ljson::node node = parser.parse(R"""({"na\rm\be\f": "c\tat", "k\ney": "val\"ue"}")""");
+	ljson::node node = parser.parse(R"""({"na\rm\be\f": "c\tat", "k\ney": "val\"ue"})""");
 
 	// clang-format off
 	EXPECT_EQ(
 R"""({
-    "k\ney": "val\"ue",
-    "na\rm\be\f": "c\tat"
+    "na\rm\be\f": "c\tat",
+    "k\ney": "val\"ue"
 })""", node.dump_to_string());
 	// clang-format on
 
-	EXPECT_NO_THROW(parser.parse(R"""({"na\rm\be\f": "c\tat", "k\ney": "val\"ue"}")"""));
+	EXPECT_NO_THROW(parser.parse(R"""({"na\rm\be\f": "c\tat", "k\ney": "val\"ue"})"""));
 	EXPECT_NO_THROW(parser.parse(R"""({"name":"cat","age":5,"smol":true,"key":null})"""));
 
-	EXPECT_TRUE(parser.try_parse(R"""({"na\rm\be\f": "c\tat", "k\ney": "val\"ue"}")"""));
+	EXPECT_TRUE(parser.try_parse(R"""({"na\rm\be\f": "c\tat", "k\ney": "val\"ue"})"""));
 	EXPECT_TRUE(parser.try_parse(R"""({"name":"cat","age":5,"smol":true,"key":null})"""));
+
+	// text after the root object is an error, the previous engine accepted this stray quote
+	EXPECT_THROW(parser.parse(R"""({"na\rm\be\f": "c\tat", "k\ney": "val\"ue"}")"""), ljson::error);
 #endif
 }
 
+TEST_F(ljson_test, parsing_nested_json)
+{
+	std::string raw_json = R"""({"a": [1, -2, [3.5, 1e2], {"b": null}], "c": {"d": {"e": "f"}}, "g": [], "h": {}})""";
+
+	ljson::node node = ljson::parser::parse(raw_json);
+
+	EXPECT_TRUE(node.at("a").is_array());
+	EXPECT_EQ(node.at("a").as_array()->size(), 4);
+	EXPECT_EQ(node.at("a").at(0).as_integer(), 1);
+	EXPECT_EQ(node.at("a").at(1).as_integer(), -2);
+	EXPECT_EQ(node.at("a").at(2).at(0).as_double(), 3.5);
+	EXPECT_EQ(node.at("a").at(2).at(1).as_double(), 100.0);
+	EXPECT_TRUE(node.at("a").at(3).at("b").is_null());
+	EXPECT_EQ(node.at("c").at("d").at("e").as_string(), "f");
+	EXPECT_TRUE(node.at("g").is_array());
+	EXPECT_TRUE(node.at("g").as_array()->empty());
+	EXPECT_TRUE(node.at("h").is_object());
+	EXPECT_TRUE(node.at("h").as_object()->empty());
+
+	auto unterminated = ljson::parser::try_parse(R"""({"a": [1, 2)""");
+	EXPECT_TRUE(not unterminated);
+	EXPECT_EQ(unterminated.error().value(), ljson::error_type::parsing_error);
+
+	auto unknown = ljson::parser::try_parse(R"""({"a": tru})""");
+	EXPECT_TRUE(not unknown);
+	EXPECT_EQ(unknown.error().value(), ljson::error_type::parsing_error_wrong_type);
+
+	EXPECT_TRUE(not ljson::parser::try_parse(R"""({"a": [1 2]})"""));
+	EXPECT_TRUE(not ljson::parser::try_parse(R"""([1, 2])"""));
+
+	// stray commas in an object are skipped like the previous engine did
+	for (const char* lenient : {"{,}", "{\"a\": 1,, \"b\": 2}"})
+	{
+		EXPECT_TRUE(ljson::parser::try_parse(lenient)) << lenient;
+		EXPECT_TRUE(ljson::parser::validate(lenient)) << lenient;
+	}
+
+	// only whitespace may follow the root object
+	EXPECT_TRUE(ljson::parser::try_parse("{\"a\": 1} \r\n\t"));
+	for (const char* trailing : {"{} x", "{\"a\": 1}}", "{\"a\":1} x", "{\"a\":1}x", "{\"a\":1}\n{\"b\":2}", "{\"a\":1} ,",
+		 "{\"a\":1} \"s\"", "{\"a\":1}{"})
+	{
+		auto extra = ljson::parser::try_parse(trailing);
+		EXPECT_TRUE(not extra) << trailing;
+		if (not extra)
+		{
+			EXPECT_EQ(extra.error().value(), ljson::error_type::parsing_error) << trailing;
+		}
+
+		auto checked = ljson::parser::validate(trailing);
+		EXPECT_TRUE(not checked) << trailing;
+		if (not checked)
+		{
+			EXPECT_EQ(checked.error().value(), ljson::error_type::parsing_error) << trailing;
+		}
+	}
+}
+
+TEST_F(ljson_test, parsing_file)
+{
+	std::filesystem::path path = std::filesystem::temp_directory_path() / "ljson_test_parsing_file.json";
+	std::ofstream(path, std::ios::binary) << "{\r\n\t\"name\": \"cat\",\r\n\t\"array\": [1, 2]\r\n}\r\n";
+
+	ljson::expected<ljson::node, ljson::error> node = ljson::parser::try_parse(path);
+	std::filesystem::remove(path);
+
+	EXPECT_TRUE(node);
+	EXPECT_EQ(node.value().at("name").as_string(), "cat");
+	EXPECT_EQ(node.value().at("array").at(1).as_integer(), 2);
+
+	auto missing = ljson::parser::try_parse(path);
+	EXPECT_TRUE(not missing);
+	EXPECT_EQ(missing.error().value(), ljson::error_type::filesystem_error);
+}
+
+TEST_F(ljson_test, parsing_views)
+{
+	std::string buffer = R"""(header{"name": "cat", "age": 5}trailer)""";
+
+	std::string_view view(buffer.data() + 6, buffer.size() - 6 - 7);
+	ljson::expected<ljson::node, ljson::error> node = ljson::parser::try_parse(view);
+	EXPECT_TRUE(node);
+	EXPECT_EQ(node.value().at("name").as_string(), "cat");
+	EXPECT_EQ(node.value().at("age").as_integer(), 5);
+
+	std::span<const std::byte> bytes = std::as_bytes(std::span(view.data(), view.size()));
+	node				 = ljson::parser::try_parse(bytes);
+	EXPECT_TRUE(node);
+	EXPECT_EQ(node.value().at("name").as_string(), "cat");
+
+	EXPECT_NO_THROW(ljson::parser::parse(view));
+	EXPECT_THROW(ljson::parser::parse(view.substr(0, view.size() - 1)), ljson::error);
+}
+
+TEST_F(ljson_test, parsing_numbers)
+{
+	ljson::node node = ljson::parser::parse(
+	    R"""({"max": 9223372036854775807, "min": -9223372036854775808, "exp": -.5e+2, "frac": 1.25})""");
+	EXPECT_EQ(node.at("max").as_integer(), INT64_MAX);
+	EXPECT_EQ(node.at("min").as_integer(), INT64_MIN);
+	EXPECT_DOUBLE_EQ(node.at("exp").as_double(), -50);
+	EXPECT_DOUBLE_EQ(node.at("frac").as_double(), 1.25);
+
+	for (std::string json : {R"""({"a": 9223372036854775808})""", R"""({"a": -99999999999999999999})""",
+		 R"""({"a": 1e400})"""})
+	{
+		auto parsed = ljson::parser::try_parse(json);
+		EXPECT_FALSE(parsed);
+		EXPECT_EQ(parsed.error().value(), ljson::error_type::number_out_of_range);
+	}
+
+	auto unknown = ljson::parser::try_parse(R"""({"a": 1e})""");
+	EXPECT_FALSE(unknown);
+	EXPECT_EQ(unknown.error().value(), ljson::error_type::parsing_error_wrong_type);
+}
+
+TEST_F(ljson_test, stringify_numbers)
+{
+	const std::map<double, std::string> doubles = {
+	    {      0.1234567, "0.1234567"},
+	    {            5.0,       "5.0"},
+	    {           -0.0,      "-0.0"},
+	    {            1e5,  "100000.0"},
+	    {           -2e7, "-20000000.0"},
+	    {  123456789.125, "123456789.125"},
+	    {        0.00001,   "0.00001"},
+	    {           1e15, "1000000000000000.0"},
+	    {           1e16,     "1e+16"},
+	    {           1e-7,     "1e-07"},
+	    {            0.1,       "0.1"},
+	    {1.7976931348623157e308, "1.7976931348623157e+308"},
+	};
+
+	for (const auto& [number, str] : doubles)
+	{
+		ljson::value value(number);
+		EXPECT_EQ(value.stringify(), str);
+
+		ljson::node node = ljson::parser::parse(std::format(R"""({{"a": {}}})""", value.stringify()));
+		EXPECT_EQ(node.at("a").as_double(), number);
+	}
+
+	EXPECT_EQ(ljson::value(INT64_MIN).stringify(), "-9223372036854775808");
+}
+
+TEST_F(ljson_test, dump_in_chunks)
+{
+	ljson::node array(ljson::node_type::array);
+	for (int i = 0; i < 20000; i++)
+		array.push_back(ljson::node({{"id", i}, {"name", "cat"}, {"tags", ljson::node({1.5, true})}}));
+
+	ljson::node root;
+	root.insert("array", array);
+
+	std::string expected = root.dump_to_string({'\t', 1});
+	std::string chunks;
+	size_t	    calls = 0;
+	root.dump(
+	    [&](const std::string& chunk)
+	    {
+		    chunks += chunk;
+		    calls++;
+	    },
+	    {'\t', 1});
+
+	EXPECT_EQ(chunks, expected);
+	EXPECT_GT(calls, 1);
+	EXPECT_EQ(ljson::parser::parse(expected).at("array").as_array()->size(), 20000);
+}
+
+TEST_F(ljson_test, dump_compact)
+{
+	ljson::node node = ljson::parser::parse(R"""(
+	{
+		"name": "cat",
+		"tags": [1, 2.5, true, null, [], {}],
+		"nested": {"a": {"b": []}}
+	}
+	)""");
+
+	std::string compact = node.dump_to_string(ljson::dump_style::compact);
+	EXPECT_EQ(compact, R"""({"name":"cat","tags":[1,2.5,true,null,[],{}],"nested":{"a":{"b":[]}}})""");
+	EXPECT_EQ(node.dump_to_string(ljson::dump_style::pretty), node.dump_to_string());
+	EXPECT_EQ(ljson::parser::parse(compact).dump_to_string(), node.dump_to_string());
+
+	std::filesystem::path path = std::filesystem::temp_directory_path() / "ljson_dump_compact.json";
+	EXPECT_TRUE(node.dump_to_file(path, ljson::dump_style::compact));
+
+	std::ifstream file(path);
+	std::string   content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	EXPECT_EQ(content, compact);
+	std::filesystem::remove(path);
+}
+
+TEST_F(ljson_test, structural_index)
+{
+	ljson::structural_index index;
+	index.build(R"""({"a": [1, "x\"]"], "b": tru e})""", ljson::simd_type::scalar);
+
+	std::vector<uint32_t> positions = {0, 1, 3, 4, 6, 7, 8, 10, 15, 16, 17, 19, 21, 22, 24, 28, 29};
+	EXPECT_EQ(index.positions(), positions);
+
+	std::vector<std::string> documents = {
+	    R"""({"name": "cat", "age": 5, "smol": true})""",
+	    R"""({"na\rm\be\f": "c\tat", "k\ney": "val\"ue"}")""",
+	    R"""({"a": [1, -2, [3.5, 1e2], {"b": null}], "c": {"d": {"e": "f"}}, "g": [], "h": {}})""",
+	    std::string(100, '\\') + "\"" + std::string(63, ' ') + "\\\\\"{}[]:,\"" + std::string(65, 'a'),
+	};
+
+	for (const auto& document : documents)
+	{
+		ljson::structural_index scalar;
+		scalar.build(document, ljson::simd_type::scalar);
+
+		for (auto type : {ljson::simd_type::sse2, ljson::simd_type::avx2, ljson::simd_type::neon})
+		{
+			if (not ljson::structural_index::is_supported(type))
+				continue;
+
+			ljson::structural_index simd;
+			simd.build(document, type);
+			EXPECT_EQ(scalar.positions(), simd.positions());
+		}
+	}
+}
+
+TEST_F(ljson_test, node_representation)
+{
+	if constexpr (sizeof(void*) == 8)
+	{
+		EXPECT_EQ(sizeof(ljson::node), 16);
+	}
+
+	ljson::node root = ljson::parser::parse(R"""({"array": [1, "two", 3.5], "flag": true})""");
+
+	ljson::node array = root.at("array");
+	array.push_back(4);
+	EXPECT_EQ(root.at("array").as_array()->size(), 4);
+
+	ljson::node flag = root.at("flag");
+	flag		 = false;
+	EXPECT_TRUE(root.at("flag").as_boolean());
+
+	std::shared_ptr<ljson::array> elements = root.at("array").as_array();
+	root				       = ljson::node();
+	array				       = ljson::node();
+	EXPECT_EQ(elements->size(), 4);
+	EXPECT_EQ(elements->at(1).as_string(), "two");
+
+	ljson::node moved = std::move(flag);
+	EXPECT_FALSE(moved.as_boolean());
+	EXPECT_TRUE(flag.is_value());
+}
+
+TEST_F(ljson_test, parsing_into_arena)
+{
+	class counting_resource : public std::pmr::memory_resource {
+		public:
+			size_t allocations   = 0;
+			size_t deallocations = 0;
+
+		private:
+			void* do_allocate(size_t bytes, size_t alignment) override
+			{
+				allocations++;
+				return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+			}
+
+			void do_deallocate(void* p, size_t bytes, size_t alignment) override
+			{
+				deallocations++;
+				std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+			}
+
+			bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+			{
+				return this == &other;
+			}
+	};
+
+	std::string raw_json = R"""({"name": "a string longer than the small string buffer", "list": [1, {"a": null}], "obj": {}})""";
+
+	counting_resource resource;
+	{
+		ljson::node node = ljson::parser::parse(raw_json, &resource);
+		EXPECT_EQ(node.at("name").as_string(), "a string longer than the small string buffer");
+		EXPECT_GT(resource.allocations, 0);
+		EXPECT_EQ(node.dump_to_string(), ljson::parser::parse(raw_json).dump_to_string());
+	}
+	EXPECT_EQ(resource.allocations, resource.deallocations);
+
+	ljson::document document = ljson::document::parse(raw_json);
+	EXPECT_EQ(document.root().at("list").at(1).at("a").as_null(), ljson::null);
+	document.root().insert("new", ljson::node(ljson::node_type::array, document.resource()));
+	document.root().at("new").push_back(std::string("value"));
+
+	ljson::document copy = document;
+	document	     = ljson::document::parse("{}");
+	EXPECT_EQ(copy.root().at("new").at(0).as_string(), "value");
+	EXPECT_TRUE(document.root().as_object()->empty());
+
+	EXPECT_FALSE(ljson::document::try_parse("{\"a\": }"));
+}
+
+TEST_F(ljson_test, object_insertion_order)
+{
+	ljson::node node = ljson::parser::parse(R"""({"z": 1, "a": 2, "m": 3, "a": 4})""");
+	EXPECT_EQ(node.dump_to_string(ljson::dump_style::compact), R"""({"z":1,"a":4,"m":3})""");
+
+	auto object = node.as_object();
+	EXPECT_EQ(object->erase("z"), 1);
+	EXPECT_EQ(object->erase("z"), 0);
+	object->insert("b", ljson::node(ljson::node_type::array));
+	EXPECT_EQ(node.dump_to_string(ljson::dump_style::compact), R"""({"a":4,"m":3,"b":[]})""");
+
+	ljson::node large;
+	for (int i = 0; i < 100; i++)
+		large.insert(std::format("key{}", 99 - i), i);
+
+	auto large_object = large.as_object();
+	EXPECT_EQ(large_object->size(), 100);
+	EXPECT_EQ(large_object->begin()->first, "key99");
+	EXPECT_EQ(large.at("key0").as_value()->as_integer(), 99);
+
+	large_object->erase(large_object->begin(), large_object->begin() + 50);
+	EXPECT_EQ(large_object->size(), 50);
+	EXPECT_FALSE(large.contains("key60"));
+	for (int i = 0; i < 50; i++)
+		EXPECT_EQ(large.at(std::format("key{}", i)).as_value()->as_integer(), 99 - i);
+
+	EXPECT_THROW(large_object->at("key60"), std::out_of_range);
+}
+
+TEST_F(ljson_test, string_view_lookup)
+{
+	ljson::node	 node = ljson::parser::parse(R"""({"name": "cat", "nested": {"age": 5}})""");
+	std::string_view key  = "nested";
+	const char*	 name = "name";
+
+	EXPECT_TRUE(node.contains(key));
+	EXPECT_TRUE(node.contains(name));
+	EXPECT_FALSE(node.contains(key.substr(0, 3)));
+	EXPECT_EQ(node.at(name).as_value()->as_string(), "cat");
+	EXPECT_EQ(node.at(key).at("age").as_value()->as_integer(), 5);
+	EXPECT_EQ(node.try_at(key).value().get().try_at(std::string("age")).value().get().as_value()->as_integer(), 5);
+	EXPECT_FALSE(node.try_at(key.substr(1)));
+
+	auto object = node.as_object();
+	EXPECT_NE(object->find(key), object->end());
+	EXPECT_TRUE(object->contains(name));
+	EXPECT_EQ(object->at(name).as_value()->as_string(), "cat");
+	EXPECT_EQ(object->erase(key), 1);
+	EXPECT_FALSE(object->contains(key));
+}
+
+TEST_F(ljson_test, borrowing_accessors)
+{
+	ljson::node node = ljson::parser::parse(R"""({"name": "cat", "tags": ["a", "b"], "nested": {"age": 5}})""");
+
+	std::string_view name = node.at("name").as_string_view();
+	EXPECT_EQ(name, "cat");
+	EXPECT_EQ(ljson::node(node.at("name")).as_string_view().data(), name.data());
+	EXPECT_FALSE(node.at("nested").try_as_string_view());
+	EXPECT_THROW(node.at("tags").at(0).as_value()->as_integer(), ljson::error);
+	EXPECT_THROW(node.at("nested").at("age").as_string_view(), ljson::error);
+	EXPECT_EQ(node.at("tags").at(1).as_value()->as_string_view(), "b");
+
+	ljson::array& tags = node.at("tags").as_array_ref();
+	EXPECT_EQ(tags.size(), 2);
+	tags.push_back(ljson::node(std::string("c")));
+	EXPECT_EQ(node.at("tags").at(2).as_string_view(), "c");
+
+	ljson::object& nested = node.at("nested").as_object_ref();
+	nested.insert("smol", ljson::node(true));
+	EXPECT_TRUE(node.at("nested").at("smol").as_boolean());
+
+	EXPECT_FALSE(node.at("name").try_as_array_ref());
+	EXPECT_THROW(node.at("tags").as_object_ref(), ljson::error);
+}
+
+TEST_F(ljson_test, typed_get)
+{
+	ljson::node node = ljson::parser::parse(
+	    R"""({"port": 8080, "ratio": 0.5, "name": "cat", "smol": true, "parent": null, "big": -5000000000})""");
+
+	EXPECT_EQ(node.at("port").get<int>(), 8080);
+	EXPECT_EQ(node.at("port").get<uint16_t>(), 8080);
+	EXPECT_EQ(node.at("port").get<double>(), 8080.0);
+	EXPECT_EQ(node.at("ratio").get<float>(), 0.5f);
+	EXPECT_EQ(node.at("name").get<std::string>(), "cat");
+	EXPECT_EQ(node.at("name").get<std::string_view>(), "cat");
+	EXPECT_TRUE(node.at("smol").get<bool>());
+	EXPECT_EQ(node.at("parent").get<ljson::null_type>(), ljson::null);
+	EXPECT_EQ(node.at("big").get<int64_t>(), -5000000000);
+
+	auto narrow = node.at("port").try_get<uint8_t>();
+	ASSERT_FALSE(narrow);
+	EXPECT_EQ(narrow.error().value(), ljson::error_type::number_out_of_range);
+	EXPECT_FALSE(node.at("big").try_get<int32_t>());
+	EXPECT_FALSE(node.at("big").try_get<uint64_t>());
+	EXPECT_FALSE(node.at("ratio").try_get<int>());
+	EXPECT_FALSE(node.at("name").try_get<double>());
+	EXPECT_THROW(node.get<int>(), ljson::error);
+}
+
+TEST_F(ljson_test, lazy_error_messages)
+{
+	ljson::node node = ljson::parser::parse(R"""({"name": "cat", "tags": []})""");
+
+	auto integer = node.at("name").try_as_integer();
+	ASSERT_FALSE(integer);
+	EXPECT_EQ(integer.error().value(), ljson::error_type::wrong_type);
+	EXPECT_EQ(integer.error().message(), "wrong type: trying to cast a 'string' value to 'integer'");
+	EXPECT_STREQ(integer.error().what(), "wrong type: trying to cast a 'string' value to 'integer'");
+
+	auto object = node.at("tags").try_as_object();
+	ASSERT_FALSE(object);
+	ljson::error copy = object.error();
+	EXPECT_EQ(copy.message(), "wrong type: trying to cast a 'node array' node to an object");
+
+	ljson::value value(std::string("meow"));
+	EXPECT_EQ(value.try_as_boolean().error().message(), "wrong type: trying to cast a 'string' value to 'boolean'");
+
+	// a miss on a string node is answered from its tag, the string isn't copied
+	ljson::node  long_string = ljson::parser::parse(R"""({"name": "a string longer than the small string buffer"})""").at("name");
+	const size_t before	 = global_allocations;
+	EXPECT_FALSE(long_string.try_as_integer());
+	EXPECT_FALSE(long_string.try_as_double());
+	EXPECT_FALSE(long_string.try_as_number());
+	EXPECT_FALSE(long_string.try_as_boolean());
+	EXPECT_FALSE(long_string.try_as_null());
+	EXPECT_FALSE(long_string.try_get<int>());
+	EXPECT_FALSE(long_string.try_get<double>());
+	EXPECT_FALSE(node.at("tags").try_as_string());
+	EXPECT_EQ(global_allocations, before);
+	EXPECT_EQ(long_string.try_get<bool>().error().message(), "wrong type: trying to cast a 'string' value to 'boolean'");
+
+	// one error read from several threads at once, every reader sees the same formatted message
+	const ljson::error	 shared = long_string.try_as_double().error();
+	std::vector<const char*> seen(4);
+	std::vector<std::thread> readers;
+	for (size_t i = 0; i < seen.size(); i++)
+		readers.emplace_back([&shared, &seen, i]() { seen[i] = shared.what(); });
+	for (auto& reader : readers)
+		reader.join();
+	for (const char* message : seen)
+	{
+		EXPECT_EQ(message, seen.front());
+		EXPECT_STREQ(message, "wrong type: trying to cast a 'string' value to 'double'");
+	}
+
+	ljson::error moved = std::move(copy);
+	EXPECT_STREQ(moved.what(), "wrong type: trying to cast a 'node array' node to an object");
+	moved = integer.error();
+	EXPECT_STREQ(moved.what(), "wrong type: trying to cast a 'string' value to 'integer'");
+}
+
+TEST_F(ljson_test, initializer_arithmetic_types)
+{
+	std::string_view	 view = "view";
+	std::vector<int64_t> ids  = {1, 2};
+
+	ljson::node node = {
+	    {"int64", int64_t(-5000000000)},
+	    {"long", 7L},
+	    {"unsigned", 8u},
+	    {"short", static_cast<short>(-3)},
+	    {"huge", std::numeric_limits<uint64_t>::max()},
+	    {"float", 1.5f},
+	    {"string", std::string("cat")},
+	    {"view", view},
+	    {"null", ljson::null},
+	    {"ids", ids},
+	    {"array", ljson::node({1u, 2L, "three"})},
+	};
+
+	EXPECT_EQ(node.at("int64").as_integer(), -5000000000);
+	EXPECT_EQ(node.at("long").as_integer(), 7);
+	EXPECT_EQ(node.at("unsigned").as_integer(), 8);
+	EXPECT_EQ(node.at("short").as_integer(), -3);
+	EXPECT_TRUE(node.at("huge").is_double());
+	EXPECT_EQ(node.at("float").as_double(), 1.5);
+	EXPECT_EQ(node.at("string").as_string(), "cat");
+	EXPECT_EQ(node.at("view").as_string(), "view");
+	EXPECT_TRUE(node.at("null").is_null());
+	EXPECT_EQ(node.at("ids").at(1).as_integer(), 2);
+	EXPECT_EQ(node.at("array").at(2).as_string(), "three");
+
+	node += {{"added", 9ull}};
+	EXPECT_EQ(node.at("added").as_integer(), 9);
+
+	ljson::node array(ljson::node_type::array);
+	array += {uint8_t(1), 2.5, true};
+	EXPECT_EQ(array.dump_to_string(ljson::dump_style::compact), "[1,2.5,true]");
+	EXPECT_THROW((array += {{"key", 1}}), ljson::error);
+
+	// a character is stored as its code, like any other integral type
+	ljson::node characters = {
+	    {"c", 'x'},
+	    {"w", L'x'},
+	    {"u8", u8'x'},
+	    {"u16", u'\u00e9'},
+	    {"u32", U'\U0001f431'},
+	};
+	EXPECT_EQ(characters.at("c").as_integer(), 'x');
+	EXPECT_EQ(characters.at("w").as_integer(), 'x');
+	EXPECT_EQ(characters.at("u8").as_integer(), 'x');
+	EXPECT_EQ(characters.at("u16").as_integer(), 0xe9);
+	EXPECT_EQ(characters.at("u32").as_integer(), 0x1f431);
+	EXPECT_EQ(characters.at("c").try_get<char>().value(), 'x');
+	EXPECT_EQ(characters.at("w").try_get<wchar_t>().value(), L'x');
+	EXPECT_EQ(characters.at("u32").try_get<char32_t>().value(), U'\U0001f431');
+	EXPECT_EQ(characters.at("u32").try_get<char16_t>().error().value(), ljson::error_type::number_out_of_range);
+	EXPECT_EQ(characters.at("u32").try_get<char8_t>().error().value(), ljson::error_type::number_out_of_range);
+}
+
+TEST_F(ljson_test, moving_nodes_in)
+{
+	ljson::node root;
+	ljson::node items(ljson::node_type::array);
+	ljson::array* storage = &items.as_array_ref();
+
+	for (int i = 0; i < 3; i++)
+		items.emplace_back(i);
+	items.emplace_back(std::string("three"));
+	items.push_back("four");
+
+	root.insert("items", std::move(items));
+	EXPECT_TRUE(items.is_value());
+	EXPECT_EQ(&root.at("items").as_array_ref(), storage);
+	EXPECT_EQ(root.at("items").dump_to_string(ljson::dump_style::compact), R"""([0,1,2,"three","four"])""");
+
+	ljson::node name(std::string("cat"));
+	std::string_view view = name.as_string_view();
+	root.insert("name", std::move(name));
+	EXPECT_EQ(root.at("name").as_string_view().data(), view.data());
+
+	ljson::object& object = root.as_object_ref();
+	auto [age, inserted] = object.emplace("age", 5);
+	EXPECT_TRUE(inserted);
+	EXPECT_EQ(age.get().as_integer(), 5);
+	EXPECT_FALSE(object.emplace("age", 6).second);
+	EXPECT_EQ(root.at("age").as_integer(), 5);
+
+	ljson::node nested(ljson::node_type::object);
+	nested.insert("smol", true);
+	root.at("age").set(std::move(nested));
+	EXPECT_TRUE(root.at("age").at("smol").as_boolean());
+	EXPECT_TRUE(nested.is_value());
+
+	EXPECT_THROW(root.emplace_back(1), ljson::error);
+}
+
+TEST_F(ljson_test, reserving_capacity)
+{
+	ljson::node array(ljson::node_type::array);
+	array.reserve(100);
+	EXPECT_GE(array.capacity(), 100);
+	EXPECT_GE(array.as_array_ref().capacity(), 100);
+	array.push_back(1);
+	array.shrink_to_fit();
+	EXPECT_EQ(array.capacity(), 1);
+
+	ljson::node object;
+	object.reserve(40);
+	EXPECT_GE(object.capacity(), 40);
+	for (int i = 0; i < 40; i++)
+		object.insert(std::format("key{}", i), i);
+	EXPECT_EQ(object.at("key39").as_integer(), 39);
+	object.as_object_ref().shrink_to_fit();
+	EXPECT_EQ(object.as_object_ref().capacity(), 40);
+
+	ljson::node value(1);
+	EXPECT_EQ(value.capacity(), 0);
+	EXPECT_THROW(value.reserve(1), ljson::error);
+
+	std::string raw_json = R"""({"items": [)""";
+	for (int i = 0; i < 1000; i++)
+		raw_json += std::format("{}{{\"id\": {}, \"tags\": [\"a\", \"b\", \"[,]\"]}}", i == 0 ? "" : ",", i);
+	raw_json += R"""(], "empty": [], "last": {"a": 1,}})""";
+
+	ljson::node node = ljson::parser::parse(raw_json);
+	EXPECT_EQ(node.capacity(), 3);
+	EXPECT_EQ(node.at("items").capacity(), 1000);
+	EXPECT_EQ(node.at("items").at(999).capacity(), 2);
+	EXPECT_EQ(node.at("items").at(999).at("tags").capacity(), 3);
+	EXPECT_EQ(node.at("empty").capacity(), 0);
+	EXPECT_EQ(node.at("last").capacity(), 2);
+}
+
+TEST_F(ljson_test, sax_events)
+{
+	struct recorder : ljson::sax_handler {
+			std::string events;
+			int64_t	    sum = 0;
+
+			bool on_object_start()
+			{
+				events += "{";
+				return true;
+			}
+
+			bool on_object_end()
+			{
+				events += "}";
+				return true;
+			}
+
+			bool on_array_start()
+			{
+				events += "[";
+				return true;
+			}
+
+			bool on_array_end()
+			{
+				events += "]";
+				return true;
+			}
+
+			bool on_key(std::string_view key)
+			{
+				events += std::format("k:{} ", key);
+				return true;
+			}
+
+			bool on_string(std::string_view string)
+			{
+				events += std::format("s:{} ", string);
+				return true;
+			}
+
+			bool on_integer(int64_t number)
+			{
+				sum += number;
+				events += std::format("i:{} ", number);
+				return true;
+			}
+
+			bool on_double(double number)
+			{
+				events += std::format("d:{} ", number);
+				return true;
+			}
+
+			bool on_boolean(bool boolean)
+			{
+				events += std::format("b:{} ", boolean);
+				return true;
+			}
+
+			bool on_null()
+			{
+				events += "null ";
+				return true;
+			}
+	};
+
+	recorder handler;
+	auto	 ok = ljson::parser::try_parse_events(
+	    R"""({"name": "c\"at", "ids": [1, 2, -3], "ratio": 0.5, "smol": true, "parent": null, "empty": {}})""", handler);
+	ASSERT_TRUE(ok);
+	EXPECT_EQ(handler.events, R"""({k:name s:c\"at k:ids [i:1 i:2 i:-3 ]k:ratio d:0.5 k:smol b:true k:parent null k:empty {}})""");
+	EXPECT_EQ(handler.sum, 0);
+
+	struct first_id : ljson::sax_handler {
+			int64_t id    = 0;
+			int	calls = 0;
+
+			bool on_integer(int64_t number)
+			{
+				id = number;
+				calls++;
+				return false;
+			}
+	};
+
+	first_id stopper;
+	auto	 stopped = ljson::parser::try_parse_events(std::string(R"""({"a": [7, 8, 9]})"""), stopper);
+	ASSERT_FALSE(stopped);
+	EXPECT_EQ(stopped.error().value(), ljson::error_type::parsing_stopped);
+	EXPECT_EQ(stopper.id, 7);
+	EXPECT_EQ(stopper.calls, 1);
+
+	ljson::sax_handler nothing;
+	EXPECT_FALSE(ljson::parser::try_parse_events(R"""({"a": [1, 2})""", nothing));
+	EXPECT_THROW(ljson::parser::parse_events(R"""({"a": tru})""", nothing), ljson::error);
+	EXPECT_NO_THROW(ljson::parser::parse_events(R"""({"a": true})""", nothing));
+
+	// the events come straight from the input, nothing is allocated on the way
+	std::string document = R"""({"name": "c\"at", "ids": [1, 2, -3, [{"deep": [0.5, 1e3]}]], "smol": true, "parent": null})""";
+	struct counter : ljson::sax_handler {
+			int keys   = 0;
+			int values = 0;
+
+			bool on_key(std::string_view)
+			{
+				keys++;
+				return true;
+			}
+
+			bool on_integer(int64_t)
+			{
+				values++;
+				return true;
+			}
+
+			bool on_double(double)
+			{
+				values++;
+				return true;
+			}
+	};
+
+	counter	     counted;
+	const size_t before = global_allocations;
+	EXPECT_TRUE(ljson::parser::try_parse_events(document, counted));
+	EXPECT_EQ(global_allocations, before);
+	EXPECT_EQ(counted.keys, 5);
+	EXPECT_EQ(counted.values, 5);
+}
+
+TEST_F(ljson_test, pull_reader)
+{
+	std::string raw_json =
+	    R"""({"skip": {"a": [1, {"b": "]}\""}], "c": "x"}, "id": 42, "ratio": 1.5e2, "tags": ["a", true, null], "rest": [[], {}]})""";
+
+	std::string   tokens;
+	ljson::reader reader(raw_json);
+	for (ljson::token token = reader.next(); token.type != ljson::token_type::end; token = reader.next())
+	{
+		tokens += std::format("{}:{} ", static_cast<int>(token.type), token.text);
+		if (token.type == ljson::token_type::key && token.text == "skip")
+		{
+			reader.skip();
+			EXPECT_EQ(reader.depth(), 1);
+		}
+	}
+	EXPECT_EQ(tokens, "0:{ 4:skip 4:id 6:42 4:ratio 6:1.5e2 4:tags 2:[ 5:a 7:true 8:null 3:] 4:rest 2:[ 2:[ 3:] 0:{ 1:} 3:] 1:} ");
+	EXPECT_EQ(reader.next().type, ljson::token_type::end);
+
+	ljson::reader fields(raw_json);
+	int64_t	      id    = 0;
+	double	      ratio = 0;
+	for (ljson::token token = fields.next(); token.type != ljson::token_type::end; token = fields.next())
+	{
+		if (token.type == ljson::token_type::key && token.text == "id")
+			id = fields.next().as_integer();
+		else if (token.type == ljson::token_type::key && token.text == "ratio")
+			ratio = fields.next().as_double();
+		else if (token.type == ljson::token_type::key)
+			fields.skip();
+	}
+	EXPECT_EQ(id, 42);
+	EXPECT_EQ(ratio, 150.0);
+
+	ljson::token string{ljson::token_type::string, "42"};
+	EXPECT_FALSE(string.try_as_integer());
+	ljson::token fraction{ljson::token_type::number, "1.5"};
+	EXPECT_FALSE(fraction.try_as_integer());
+	EXPECT_THROW(fraction.as_integer(), ljson::error);
+
+	ljson::reader unclosed(R"""({"a": [1, 2)""");
+	EXPECT_TRUE(unclosed.try_next());
+	EXPECT_FALSE(unclosed.try_skip());
+
+	// a closing bracket isn't skipped, it is left for next()
+	ljson::reader closing(R"""({"a": [1], "b": {}})""");
+	EXPECT_EQ(closing.next().type, ljson::token_type::start_object);
+	EXPECT_EQ(closing.next().type, ljson::token_type::key);
+	EXPECT_EQ(closing.next().type, ljson::token_type::start_array);
+	EXPECT_TRUE(closing.try_skip());
+	auto end_of_array = closing.try_skip();
+	ASSERT_FALSE(end_of_array);
+	EXPECT_EQ(end_of_array.error().value(), ljson::error_type::wrong_type);
+	EXPECT_EQ(closing.depth(), 2);
+	EXPECT_EQ(closing.next().type, ljson::token_type::end_array);
+	EXPECT_EQ(closing.next().text, "b");
+	EXPECT_EQ(closing.next().type, ljson::token_type::start_object);
+	EXPECT_THROW(closing.skip(), ljson::error);
+	EXPECT_EQ(closing.next().type, ljson::token_type::end_object);
+	EXPECT_EQ(closing.depth(), 1);
+	EXPECT_FALSE(closing.try_skip());
+	EXPECT_EQ(closing.next().type, ljson::token_type::end_object);
+	EXPECT_EQ(closing.next().type, ljson::token_type::end);
+
+	ljson::reader broken(R"""({"a": tru})""");
+	EXPECT_TRUE(broken.try_next());
+	EXPECT_TRUE(broken.try_next());
+	EXPECT_FALSE(broken.try_next());
+}
+
+TEST_F(ljson_test, stream_parser_chunks)
+{
+	std::string raw_json = R"""({
+	"name": "c\\\"at {[,:",
+	"ids": [12345, -6789, 1.25e3],
+	"flags": {"smol": true, "big": false, "parent": null},
+	"empty": [{}, []]
+})""";
+	std::string expected = ljson::parser::parse(raw_json).dump_to_string();
+
+	ljson::stream_parser parser;
+	for (size_t chunk_size : {1, 2, 3, 7, 64})
+	{
+		for (size_t i = 0; i < raw_json.size(); i += chunk_size)
+			ASSERT_TRUE(parser.try_feed(std::string_view(raw_json).substr(i, chunk_size)));
+
+		auto node = parser.try_finish();
+		ASSERT_TRUE(node) << node.error().message();
+		EXPECT_EQ(node.value().dump_to_string(), expected) << "chunk size: " << chunk_size;
+	}
+
+	// a string over many chunks, 64 KB isn't a multiple of 3 so some chunks end between '\\' and '"'
+	std::string escapes;
+	for (int i = 0; i < 100000; i++)
+		escapes += "a\\\"";
+	std::string long_string = std::format(R"""({{"s": "{}{}", "n": [1, 2]}})""", std::string(4 * 1024 * 1024, 'x'), escapes);
+	for (size_t i = 0; i < long_string.size(); i += 64 * 1024)
+		ASSERT_TRUE(parser.try_feed(std::string_view(long_string).substr(i, 64 * 1024)));
+	auto streamed = parser.try_finish();
+	ASSERT_TRUE(streamed) << streamed.error().message();
+	EXPECT_EQ(streamed.value().at("s").as_string_view().size(), 4 * 1024 * 1024 + escapes.size());
+	EXPECT_EQ(streamed.value().at("n").at(1).as_integer(), 2);
+
+	std::string bytes = R"""({"a": 1})""";
+	parser.feed(std::as_bytes(std::span(bytes)));
+	EXPECT_EQ(parser.finish().at("a").as_integer(), 1);
+
+	parser.feed("{\n\"a\": 1,\n");
+	auto wrong = parser.try_feed("\"b\" 2}");
+	ASSERT_FALSE(wrong);
+	EXPECT_NE(wrong.error().message().find("line: 3"), std::string::npos) << wrong.error().message();
+	EXPECT_FALSE(parser.try_feed("}"));
+	EXPECT_FALSE(parser.try_finish());
+
+	parser.feed(R"""({"a": [1, 2]})""");
+	parser.feed(" x");
+	EXPECT_FALSE(parser.try_finish());
+
+	parser.feed(R"""({"a": [1, 2)""");
+	EXPECT_THROW(parser.finish(), ljson::error);
+	EXPECT_TRUE(parser.finish().is_object());
+}
+
+TEST_F(ljson_test, ndjson_records)
+{
+	std::string raw_json;
+	for (int i = 0; i < 20000; i++)
+		raw_json += std::format("{{\"id\": {}, \"message\": \"record number {}\"}}\n{}", i, i, i % 1000 == 0 ? "\r\n" : "");
+
+	std::vector<int64_t> ids;
+	for (const ljson::expected<ljson::node, ljson::error>& record : ljson::ndjson(raw_json))
+	{
+		ASSERT_TRUE(record);
+		ids.push_back(record.value().at("id").as_integer());
+	}
+	ASSERT_EQ(ids.size(), 20000);
+
+	auto records = ljson::ndjson::try_parse(raw_json, 4);
+	ASSERT_TRUE(records) << records.error().message();
+	ASSERT_EQ(records.value().size(), ids.size());
+	for (size_t i = 0; i < ids.size(); i++)
+		EXPECT_EQ(records.value()[i].at("id").as_integer(), static_cast<int64_t>(i));
+
+	int64_t sum = 0;
+	ljson::ndjson::for_each(raw_json, [&](ljson::node& record) { sum += record.at("id").as_integer(); }, ljson::ndjson_order::unordered, 4);
+	EXPECT_EQ(sum, 19999LL * 20000 / 2);
+
+	std::string broken = raw_json + "{\"id\": tru}\n" + raw_json;
+	size_t	    line   = 1 + std::count(raw_json.begin(), raw_json.end(), '\n');
+	auto	    failed = ljson::ndjson::try_parse(broken, 4);
+	ASSERT_FALSE(failed);
+	EXPECT_NE(failed.error().message().find(std::format("line: {}", line)), std::string::npos) << failed.error().message();
+
+	size_t delivered = 0;
+	EXPECT_FALSE(ljson::ndjson::try_for_each(broken, [&](ljson::node&) { delivered++; }, ljson::ndjson_order::ordered, 4));
+	EXPECT_EQ(delivered, 20000);
+
+	// the chunks that were being parsed when the first one failed aren't delivered
+	delivered = 0;
+	EXPECT_FALSE(ljson::ndjson::try_for_each("{\"id\": tru}\n" + raw_json, [&](ljson::node&) { delivered++; }, ljson::ndjson_order::unordered, 4));
+	EXPECT_EQ(delivered, 0);
+
+	EXPECT_THROW(ljson::ndjson::for_each(raw_json, [](ljson::node&) { throw std::runtime_error("stop"); }, ljson::ndjson_order::unordered, 4),
+	    std::runtime_error);
+	EXPECT_THROW(ljson::ndjson::parse("{}\n[1]\n", 1), ljson::error);
+}
+
+TEST_F(ljson_test, parallel_array_parsing)
+{
+	std::string elements;
+	for (int i = 0; i < 20000; i++)
+		elements += std::format("{{\"id\": {}, \"tags\": [\"a,]\", {}]}},\n\t{}, \"s{}\", ", i, i % 2 == 0, i * 0.5, i);
+	elements += "null";
+
+	std::string raw_json = std::format(R"""({{"meta": {{"count": 1}}, "data": {{"rows": [{}], "small": [1, 2]}}, "after": true}})""", elements);
+	ASSERT_GT(raw_json.size(), ljson::parser::min_parallel_size);
+
+	auto expected = ljson::parser::try_parse(raw_json);
+	ASSERT_TRUE(expected);
+	auto parallel = ljson::parser::try_parse_parallel(raw_json, 4);
+	ASSERT_TRUE(parallel) << parallel.error().message();
+	EXPECT_EQ(parallel.value().at("data").at("rows").as_array_ref().size(), 60001);
+	EXPECT_EQ(parallel.value().dump_to_string(), expected.value().dump_to_string());
+
+	std::string trailing = raw_json;
+	trailing.insert(trailing.find("null]") + 4, ",");
+	EXPECT_EQ(ljson::parser::parse_parallel(trailing, 4).dump_to_string(), ljson::parser::parse(trailing).dump_to_string());
+
+	// a last element bigger than a chunk followed by a trailing comma, the comma can't end a chunk
+	std::string numbers;
+	for (int i = 0; i < 70000; i++)
+		numbers += "1234567, ";
+	std::string large_last = std::format(R"""({{"a": [{}"{}",]}})""", numbers, std::string(600 * 1024, 'x'));
+	for (size_t threads : {2, 3, 4, 8})
+	{
+		auto split = ljson::parser::try_parse_parallel(large_last, threads);
+		ASSERT_TRUE(split) << threads << ": " << split.error().message();
+		EXPECT_EQ(split.value().dump_to_string(), ljson::parser::parse(large_last).dump_to_string()) << threads;
+	}
+
+	std::string broken = raw_json;
+	broken.replace(broken.find("\"s15000\""), 8, "tru");
+	auto failed = ljson::parser::try_parse_parallel(broken, 4);
+	ASSERT_FALSE(failed);
+	EXPECT_EQ(failed.error().message(), ljson::parser::try_parse(broken).error().message());
+
+	std::string unbalanced = raw_json;
+	unbalanced.replace(unbalanced.find("false]"), 6, "false}");
+	EXPECT_FALSE(ljson::parser::try_parse_parallel(unbalanced, 4));
+	EXPECT_FALSE(ljson::parser::try_parse_parallel("{\"a\": tru, " + raw_json.substr(1), 4));
+}
+
+TEST_F(ljson_test, validate_only)
+{
+	EXPECT_TRUE(ljson::parser::validate(R"""({"a": [1, 2.5, -3e2, "x\"y", true, false, null, {"b": {"c": []}}], "d": "meow"})"""));
+	EXPECT_TRUE(ljson::parser::validate(""));
+
+	auto wrong = ljson::parser::validate("{\n\"a\": [1, 2,\n\"b\" tru]}");
+	ASSERT_FALSE(wrong);
+	EXPECT_EQ(wrong.error().value(), ljson::error_type::parsing_error);
+	EXPECT_NE(wrong.error().message().find("line: 3, offset: 18"), std::string::npos) << wrong.error().message();
+
+	auto range = ljson::parser::validate(R"""({"a": 1e400})""");
+	ASSERT_FALSE(range);
+	EXPECT_EQ(range.error().value(), ljson::error_type::number_out_of_range);
+
+	// deeper than the scopes kept in place
+	std::string deep = "{\"a\": " + std::string(300, '[') + std::string(300, ']') + "}";
+	EXPECT_TRUE(ljson::parser::validate(deep));
+	EXPECT_TRUE(ljson::parser::try_parse(deep));
+	deep.pop_back();
+	deep.pop_back();
+	EXPECT_FALSE(ljson::parser::validate(deep));
+	EXPECT_FALSE(ljson::parser::try_parse(deep));
+
+	// strings and numbers longer than the 8 bytes that are checked at once
+	EXPECT_TRUE(ljson::parser::validate(
+	    R"""({"long key, not a number": "0123456789\\\"\\\\abcdef\"", "n": [-123456789012345678, 0.000000000000000000001]})"""));
+	EXPECT_FALSE(ljson::parser::validate(R"""({"long key, not a number": "0123456789\x"})"""));
+	EXPECT_FALSE(ljson::parser::validate(R"""({"long key, not a number": "0123456789\"})"""));
+	EXPECT_EQ(ljson::parser::validate(R"""({"n": 12345678901234567890})""").error().value(), ljson::error_type::number_out_of_range);
+}
+
 TEST_F(ljson_test, node_add_object)
 {
 	ljson::node node = {